@@ -7,7 +7,11 @@
 //  file, You can obtain one at http://mozilla.org/MPL/2.0/.
 // ========================================================================================
 
+#include <map>
+
 #include "ApproxMVBB/ComputeApproxMVBB.hpp"
+#include "ApproxMVBB/ExactMVBB.hpp"
+#include "ApproxMVBB/PointCloudFile.hpp"
 
 #include "CommonFunctions.hpp"
 #include "benchmark/benchmark.h"
@@ -37,6 +41,81 @@ namespace ApproxMVBB
         {
             auto oobb = ApproxMVBB::approximateMVBB(v, eps, nPoints, gridSize, mvbbDiamOptLoops, gridSearchOptLoops);
         }
+
+        /** Convex hull of `v` with the algorithm state.range(0) (see ConvexHull2D::Algorithm) */
+        template<typename TMatrix>
+        void convexHullBenchmark(benchmark::State& state, const TMatrix& v)
+        {
+            auto algorithm = static_cast<ConvexHull2D::Algorithm>(state.range(0));
+            ConvexHull2D::Buffers buffers;
+            while(state.KeepRunning())
+            {
+                ConvexHull2D c(v, buffers);
+                c.compute(algorithm);
+                benchmark::DoNotOptimize(c.getIndices().data());
+            }
+        }
+
+        /** Read the text point cloud `filePath` with the iostream loop (state.range(0) == 0)
+            or with the parallel parser readPointCloudText (state.range(0) == 1) */
+        void readTextBenchmark(benchmark::State& state, const std::string& filePath)
+        {
+            std::size_t nPoints = 0;
+            while(state.KeepRunning())
+            {
+                if(state.range(0) == 0)
+                {
+                    auto v  = TestFunctions::getPointsFromFile3D(filePath);
+                    nPoints = v.size();
+                }
+                else
+                {
+                    Matrix3Dyn t;
+                    readPointCloudText(filePath, t);
+                    nPoints = t.cols();
+                }
+            }
+            state.counters["points"] = static_cast<double>(nPoints);
+        }
+
+        /** Largest distance of the points `v` (in double) outside of the box `oobb`
+            relative to the maximal extent of the box */
+        template<typename TMatrix>
+        double relativeOutsideDistance(const TMatrix& v, const OOBB& oobb)
+        {
+            using Vector3d  = MyMatrix::Vector3<double>;
+            using Matrix33d = MyMatrix::Matrix33<double>;
+            Matrix33d A_KI    = oobb.m_q_KI.matrix().template cast<double>().transpose();
+            Vector3d minPoint = oobb.m_minPoint.template cast<double>();
+            Vector3d maxPoint = oobb.m_maxPoint.template cast<double>();
+            double outside    = 0;
+            for(decltype(v.cols()) i = 0; i < v.cols(); ++i)
+            {
+                Vector3d p = A_KI * v.col(i);
+                outside    = std::max(outside, (minPoint - p).cwiseMax(p - maxPoint).maxCoeff());
+            }
+            return outside / oobb.maxExtent();
+        }
+
+        /** Grid search of approximateMVBB on the sample of `t` without (state.range(0) == 0)
+            or with (state.range(0) == 1) pruning of the directions */
+        void gridSearchPruningBenchmark(benchmark::State& state, const Matrix3Dyn& t)
+        {
+            MVBBWorkspace workspace;
+            OOBB start = approximateMVBBDiam(t, workspace, 0.001);
+            samplePointsGrid(workspace.m_sampled, t, 400, start, workspace.m_sampleGrid);
+            Matrix3Dyn sample = workspace.m_sampled;
+
+            OOBB oobb;
+            while(state.KeepRunning())
+            {
+                oobb = approximateMVBBGridSearch(
+                    sample, start, workspace, 0.001, 5, 6, 1e-6, 1e-12, state.range(0) == 1);
+            }
+            state.counters["pruned"] =
+                static_cast<double>(workspace.m_prunedDirections) / static_cast<double>(workspace.m_gridDirections);
+            state.counters["volume"] = static_cast<double>(oobb.volume());
+        }
     }  // namespace MVBBBenchmarks
 }  // namespace ApproxMVBB
 
@@ -91,8 +170,415 @@ MY_BENCHMARK(lucy)
     }
 }
 
+MY_BENCHMARK(computeMVBB)
+{
+    MY_BENCHMARK_RANDOM_STUFF(computeMVBB);
+    Matrix3Dyn t(3, state.range(0));
+    t = t.unaryExpr(f);
+    ProjectedPointSet proj;
+    std::cout << "Start..." << std::endl;
+    while(state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(proj.computeMVBB(Vector3(1, 2, 3), t));
+    }
+}
+
+MY_BENCHMARK(computeMVBBStreaming)
+{
+    MY_BENCHMARK_RANDOM_STUFF(computeMVBBStreaming);
+    Matrix3Dyn t(3, state.range(0));
+    t = t.unaryExpr(f);
+    ProjectedPointSet proj;
+    std::cout << "Start..." << std::endl;
+    while(state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(proj.computeMVBBStreaming(Vector3(1, 2, 3), t));
+    }
+}
+
+MY_BENCHMARK(estimateDiameter)
+{
+    // Diameter of state.range(1) random points on a pointer list (state.range(0) == 0)
+    // or on contiguous storage (state.range(0) == 1)
+    MY_BENCHMARK_RANDOM_STUFF(estimateDiameter);
+    Matrix3Dyn points(3, state.range(1));
+    points = points.unaryExpr(f);
+    applyRandomRotTrans(points, f);
+    const MyMatrix::MatrixStatDyn<double, 3> t = points.cast<double>();  // the pointer list needs double
+    DiameterEstimator estimator;
+    std::vector<double const*> pointList(t.cols());
+    std::cout << "Start..." << std::endl;
+    while(state.KeepRunning())
+    {
+        if(state.range(0) == 0)
+        {
+            for(unsigned int i = 0; i < t.cols(); ++i)
+            {
+                pointList[i] = t.col(i).data();
+            }
+            Diameter::TypeSegment segment;
+            benchmark::DoNotOptimize(estimator.estimateDiameter(
+                &segment, pointList.data(), 0, static_cast<int>(t.cols() - 1), 3, 0.001));
+        }
+        else
+        {
+            unsigned int index1, index2;
+            benchmark::DoNotOptimize(estimator.estimateDiameter3D(
+                &index1, &index2, t.data(), t.data() + 1, t.data() + 2, static_cast<unsigned int>(t.cols()), 3, 0.001));
+        }
+    }
+}
+
+MY_BENCHMARK(convexHullPointCloud)
+{
+    MY_BENCHMARK_RANDOM_STUFF(convexHullPointCloud);
+    auto v = getPointsFromFile3D(getFileInPath("PointCloud_" + std::to_string(state.range(1)) + ".txt"));
+    Matrix3Dyn t(3, v.size());
+    for(unsigned int i = 0; i < v.size(); ++i)
+    {
+        t.col(i) = v[i];
+    }
+    applyRandomRotTrans(t, f);
+    Matrix2Dyn p = t.topRows<2>();
+    convexHullBenchmark(state, p);
+}
+
+MY_BENCHMARK(convexHullRandom)
+{
+    MY_BENCHMARK_RANDOM_STUFF(convexHullRandom);
+    Matrix2Dyn p(2, state.range(1));
+    p = p.unaryExpr(f);
+    convexHullBenchmark(state, p);
+}
+
+MY_BENCHMARK(precision)
+{
+    // Run in the double and the float build (ApproxMVBB_PREC) to compare speed and accuracy:
+    // the points are generated in double and rounded to PREC, the counters report the
+    // volume and how far the points lie outside of the box (evaluated in double).
+    MY_BENCHMARK_RANDOM_STUFF(precision);
+    ApproxMVBB::RandomGenerators::DefaultUniformRealDistribution<double> uniDouble(0.0, 1.0);
+    MyMatrix::MatrixStatDyn<double, 3> d(3, state.range(0));
+    d = d.unaryExpr([&](double) { return uniDouble(rng); });
+    d = Eigen::AngleAxis<double>(0.5, Eigen::Vector3d(1, 2, 3).normalized()).toRotationMatrix() *
+        (d.array() * 100.0 + 1000.0).matrix();
+    Matrix3Dyn t = d.cast<PREC>();
+
+    MVBBWorkspace workspace;
+    OOBB oobb;
+    std::cout << "Start..." << std::endl;
+    while(state.KeepRunning())
+    {
+        oobb = approximateMVBB(t, workspace, 0.001, 400, 5, 2, 10);
+
+        // Make all points inside the OOBB
+        Matrix33 A_KI = oobb.m_q_KI.matrix().transpose();
+        for(decltype(t.cols()) i = 0; i < t.cols(); ++i)
+        {
+            oobb.unite(A_KI * t.col(i));
+        }
+        benchmark::DoNotOptimize(oobb.m_minPoint.data());
+    }
+    state.counters["volume"]  = static_cast<double>(oobb.volume());
+    state.counters["outside"] = relativeOutsideDistance(d, oobb);
+    state.counters["bytes"]   = static_cast<double>(sizeof(PREC));
+}
+
+MY_BENCHMARK(warmStart)
+{
+    // Moving body (100000 points), each iteration is one frame computed with
+    // approximateMVBB (state.range(0) == 0) or approximateMVBBWarmStart (state.range(0) == 1)
+    MY_BENCHMARK_RANDOM_STUFF(warmStart);
+    Matrix3Dyn body(3, 100000);
+    body = body.unaryExpr(f);
+    body.row(0) *= 4.0;
+    body.row(1) *= 2.0;
+
+    MVBBWorkspace workspace;
+    OOBB oobb = approximateMVBB(body, workspace, 0.001, 400, 5, 0, 6);
+    Matrix3Dyn t(3, body.cols());
+    unsigned int frame = 0;
+    std::cout << "Start..." << std::endl;
+    while(state.KeepRunning())
+    {
+        state.PauseTiming();
+        ++frame;
+        t = AngleAxis(0.01 * frame, Vector3(1, 2, 3).normalized()).toRotationMatrix() * body;
+        state.ResumeTiming();
+
+        if(state.range(0) == 0)
+        {
+            oobb = approximateMVBB(t, workspace, 0.001, 400, 5, 0, 6);
+        }
+        else
+        {
+            oobb = approximateMVBBWarmStart(t, oobb, workspace, 0.001, 400, 2, 5, 6, 1.1);
+        }
+        benchmark::DoNotOptimize(oobb.m_minPoint.data());
+    }
+    state.counters["volume"] = static_cast<double>(oobb.volume());
+}
+
+MY_BENCHMARK(gridSearchPruningBunny)
+{
+    MY_BENCHMARK_RANDOM_STUFF(gridSearchPruningBunny);
+    auto v = getPointsFromFile3D(getFileInPath("Bunny.txt"));
+    Matrix3Dyn t(3, v.size());
+    for(unsigned int i = 0; i < v.size(); ++i)
+    {
+        t.col(i) = v[i];
+    }
+    applyRandomRotTrans(t, f);
+    std::cout << "Start..." << std::endl;
+    gridSearchPruningBenchmark(state, t);
+}
+
+MY_BENCHMARK(gridSearchPruningRandom)
+{
+    MY_BENCHMARK_RANDOM_STUFF(gridSearchPruningRandom);
+    Matrix3Dyn t(3, 100000);
+    t = t.unaryExpr(f);
+    applyRandomRotTrans(t, f);
+    std::cout << "Start..." << std::endl;
+    gridSearchPruningBenchmark(state, t);
+}
+
+MY_BENCHMARK(convexHull3D)
+{
+    // approximateMVBB on 1M points in a ball without (state.range(0) == 0) and with
+    // (state.range(0) == 1) the reduction to the 3d convex hull vertices
+    MY_BENCHMARK_RANDOM_STUFF(convexHull3D);
+    Matrix3Dyn t(3, 1000000);
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        Vector3 p = Vector3(f(0), f(0), f(0)) - Vector3::Constant(0.5);
+        t.col(i)  = p.normalized() * std::cbrt(f(0));
+    }
+    t.row(0) *= 3.0;
+
+    MVBBWorkspace workspace;
+    OOBB oobb;
+    std::cout << "Start..." << std::endl;
+    while(state.KeepRunning())
+    {
+        oobb = approximateMVBB(
+            t, workspace, 0.001, 400, 5, 2, 6, RandomGenerators::defaultSeed, state.range(0) == 1);
+    }
+
+    // Make all points inside the OOBB
+    Matrix33 A_KI = oobb.m_q_KI.matrix().transpose();
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        oobb.unite(A_KI * t.col(i));
+    }
+    auto vertices              = state.range(0) == 1 ? workspace.m_hullVertices.cols() : t.cols();
+    state.counters["vertices"] = static_cast<double>(vertices);
+    state.counters["volume"]   = static_cast<double>(oobb.volume());
+}
+
+MY_BENCHMARK(exactMVBB)
+{
+    // exactMVBB on the point clouds of tests/files (state.range(0): PointCloud_0-50, Bunny,
+    // PointsSimulation, PointsSimulationFailMVBB and the planar sets PointsSimulation2DRectFail,
+    // PointsBadProjection-6 in the plane z = 0) and the relative volume gap of approximateMVBB
+    // (zero for the planar sets)
+    static const std::vector<std::string> files = [] {
+        std::vector<std::string> names;
+        for(int k = 0; k <= 50; ++k)
+        {
+            names.push_back("PointCloud_" + std::to_string(k) + ".txt");
+        }
+        names.insert(names.end(), {"Bunny.txt", "PointsSimulation.txt", "PointsSimulationFailMVBB.txt"});
+        names.insert(names.end(), {"PointsSimulation2DRectFail.txt", "PointsBadProjection.bin"});
+        for(int k = 2; k <= 6; ++k)
+        {
+            names.push_back("PointsBadProjection" + std::to_string(k) + ".bin");
+        }
+        return names;
+    }();
+    // Number of points of the binary files (stored without header as doubles)
+    static const std::map<std::string, unsigned int> binarySizes = {{"PointsBadProjection.bin", 400},
+                                                                    {"PointsBadProjection2.bin", 400},
+                                                                    {"PointsBadProjection3.bin", 400},
+                                                                    {"PointsBadProjection4.bin", 16},
+                                                                    {"PointsBadProjection5.bin", 5},
+                                                                    {"PointsBadProjection6.bin", 100}};
+
+    const std::string& file = files[state.range(0)];
+    Matrix3Dyn t;
+    if(binarySizes.count(file))
+    {
+        Eigen::Matrix<double, 2, Eigen::Dynamic> v(2, binarySizes.at(file));
+        readPointsMatrixBinary(getFileInPath(file), v, false);
+        t.setZero(3, v.cols());
+        t.topRows<2>() = v.cast<PREC>();
+    }
+    else if(file == "PointsSimulation2DRectFail.txt")
+    {
+        auto v = getPointsFromFile2D(getFileInPath(file));
+        t.setZero(3, v.size());
+        for(unsigned int i = 0; i < v.size(); ++i)
+        {
+            t.col(i).head<2>() = v[i];
+        }
+    }
+    else
+    {
+        auto v = getPointsFromFile3D(getFileInPath(file));
+        t.resize(3, v.size());
+        for(unsigned int i = 0; i < v.size(); ++i)
+        {
+            t.col(i) = v[i];
+        }
+    }
+
+    OOBB exact;
+    std::cout << "Start..." << std::endl;
+    while(state.KeepRunning())
+    {
+        exact = exactMVBB(t);
+    }
+
+    // Make all points inside the approximate OOBB
+    OOBB oobb     = approximateMVBB(t, 0.001, 400, 5, 0, 6);
+    Matrix33 A_KI = oobb.m_q_KI.matrix().transpose();
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        oobb.unite(A_KI * t.col(i));
+    }
+    state.SetLabel(file);
+    state.counters["volume"] = static_cast<double>(exact.volume());
+    state.counters["gap"]    = exact.volume() > 0 ? static_cast<double>(oobb.volume() / exact.volume() - 1) : 0.0;
+}
+
+MY_BENCHMARK(sampleGridMode)
+{
+    // approximateMVBB on an elongated point cloud with the SampleGridMode state.range(0)
+    // and state.range(1) sample points
+    MY_BENCHMARK_RANDOM_STUFF(sampleGridMode);
+    Matrix3Dyn t(3, 1000000);
+    t = t.unaryExpr(f);
+    t.row(0) *= 20.0;
+    t.row(1) *= 2.0;
+    applyRandomRotTrans(t, f);
+
+    auto mode = static_cast<SampleGridMode>(state.range(0));
+    MVBBWorkspace workspace;
+    OOBB oobb;
+    std::cout << "Start..." << std::endl;
+    while(state.KeepRunning())
+    {
+        oobb = approximateMVBB(
+            t, workspace, 0.001, state.range(1), 5, 0, 6, RandomGenerators::defaultSeed, false, mode);
+    }
+
+    // Make all points inside the OOBB
+    Matrix33 A_KI = oobb.m_q_KI.matrix().transpose();
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        oobb.unite(A_KI * t.col(i));
+    }
+    state.counters["volume"] = static_cast<double>(oobb.volume());
+}
+
+MY_BENCHMARK(samplePadding)
+{
+    // approximateMVBB on points with skewed density in a wedge (many grid cells are empty or sparse)
+    // with the SamplePadding state.range(0) and state.range(1) sample points, the error is relative to exactMVBB
+    MY_BENCHMARK_RANDOM_STUFF(samplePadding);
+    Matrix3Dyn t(3, 1000000);
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        Vector3 p(f(0), f(0), f(0));
+        t.col(i) = Vector3(4 * p(0) * p(0) * p(0), 2 * p(1), p(2) * p(0));
+    }
+    applyRandomRotTrans(t, f);
+    static const PREC exactVolume = exactMVBB(t).volume();
+
+    auto padding = static_cast<SamplePadding>(state.range(0));
+    MVBBWorkspace workspace;
+    OOBB oobb;
+    std::cout << "Start..." << std::endl;
+    while(state.KeepRunning())
+    {
+        oobb = approximateMVBB(t,
+                               workspace,
+                               0.001,
+                               state.range(1),
+                               5,
+                               0,
+                               6,
+                               RandomGenerators::defaultSeed,
+                               false,
+                               SampleGridMode::Square,
+                               padding);
+    }
+
+    // Make all points inside the OOBB
+    Matrix33 A_KI = oobb.m_q_KI.matrix().transpose();
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        oobb.unite(A_KI * t.col(i));
+    }
+    state.counters["error"] = static_cast<double>(oobb.volume() / exactVolume - 1);
+}
+
+MY_BENCHMARK(readTextBunny)
+{
+    readTextBenchmark(state, getFileInPath("Bunny.txt"));
+}
+
+MY_BENCHMARK(readText10M)
+{
+    MY_BENCHMARK_RANDOM_STUFF(readText10M);
+    // Generate the file once
+    auto filePath = getFileOutPath(testName, ".txt");
+    if(!std::ifstream(filePath).good())
+    {
+        Matrix3Dyn t(3, 10000000);
+        t = t.unaryExpr(f);
+        dumpPointsMatrix(filePath, t);
+    }
+    readTextBenchmark(state, filePath);
+}
+
 MY_BENCHMARK_REGISTER(bunny)->Unit(benchmark::kMillisecond);
 MY_BENCHMARK_REGISTER(random140M)->Unit(benchmark::kMillisecond)->MinTime(7000);
 MY_BENCHMARK_REGISTER(lucy)->Unit(benchmark::kMillisecond)->MinTime(7000);
+MY_BENCHMARK_REGISTER(computeMVBB)->Unit(benchmark::kMillisecond)->Arg(1000000)->Arg(10000000);
+MY_BENCHMARK_REGISTER(computeMVBBStreaming)->Unit(benchmark::kMillisecond)->Arg(1000000)->Arg(10000000);
+MY_BENCHMARK_REGISTER(estimateDiameter)->Unit(benchmark::kMillisecond)->Apply([](benchmark::internal::Benchmark* b) {
+    for(int contiguous = 0; contiguous < 2; ++contiguous)
+        for(int n : {1000000, 10000000})
+            b->Args({contiguous, n});
+});
+MY_BENCHMARK_REGISTER(readTextBunny)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(1);
+MY_BENCHMARK_REGISTER(readText10M)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(1);
+MY_BENCHMARK_REGISTER(gridSearchPruningBunny)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(1);
+MY_BENCHMARK_REGISTER(gridSearchPruningRandom)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(1);
+MY_BENCHMARK_REGISTER(convexHull3D)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(1);
+MY_BENCHMARK_REGISTER(warmStart)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(1);
+MY_BENCHMARK_REGISTER(exactMVBB)->Unit(benchmark::kMillisecond)->DenseRange(0, 60);
+MY_BENCHMARK_REGISTER(sampleGridMode)->Unit(benchmark::kMillisecond)->Apply([](benchmark::internal::Benchmark* b) {
+    for(int mode = 0; mode < 3; ++mode)
+        for(int n : {50, 100, 400})
+            b->Args({mode, n});
+});
+MY_BENCHMARK_REGISTER(samplePadding)->Unit(benchmark::kMillisecond)->Apply([](benchmark::internal::Benchmark* b) {
+    for(int padding = 0; padding < 4; ++padding)
+        for(int n : {100, 400})
+            b->Args({padding, n});
+});
+MY_BENCHMARK_REGISTER(precision)->Unit(benchmark::kMillisecond)->Arg(1000000)->Arg(10000000);
+MY_BENCHMARK_REGISTER(convexHullPointCloud)->Unit(benchmark::kMillisecond)->Apply([](benchmark::internal::Benchmark* b) {
+    for(int algorithm = 0; algorithm < 4; ++algorithm)
+        for(int k = 0; k < 4; ++k)
+            b->Args({algorithm, k});
+});
+MY_BENCHMARK_REGISTER(convexHullRandom)->Unit(benchmark::kMillisecond)->Apply([](benchmark::internal::Benchmark* b) {
+    for(int algorithm = 0; algorithm < 4; ++algorithm)
+        for(int n : {1 << 16, 1 << 20, 1 << 24})
+            b->Args({algorithm, n});
+});
 
 BENCHMARK_MAIN();
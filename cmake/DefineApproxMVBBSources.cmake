@@ -36,9 +36,13 @@ macro(INCLUDE_ALL_ApproxMVBB_SOURCE
         ${ApproxMVBB_ROOT_DIR}/src/ApproxMVBB/Common/MyMatrixTypeDefs.cpp
         ${ApproxMVBB_ROOT_DIR}/src/ApproxMVBB/RandomGenerators.cpp
         ${ApproxMVBB_ROOT_DIR}/src/ApproxMVBB/ConvexHull2D.cpp
+        ${ApproxMVBB_ROOT_DIR}/src/ApproxMVBB/ConvexHull3D.cpp
+        ${ApproxMVBB_ROOT_DIR}/src/ApproxMVBB/ExactMVBB.cpp
         ${ApproxMVBB_ROOT_DIR}/src/ApproxMVBB/MinAreaRectangle.cpp
         ${ApproxMVBB_ROOT_DIR}/src/ApproxMVBB/ProjectedPointSet.cpp
         ${ApproxMVBB_ROOT_DIR}/src/ApproxMVBB/OOBB.cpp
+        ${ApproxMVBB_ROOT_DIR}/src/ApproxMVBB/GridDirections.cpp
+        ${ApproxMVBB_ROOT_DIR}/src/ApproxMVBB/PointCloudFile.cpp
         ${ApproxMVBB_ROOT_DIR}/src/ApproxMVBB/AABB.cpp
 
         ${ApproxMVBB_DIAM_SRC}
@@ -65,15 +69,23 @@ macro(INCLUDE_ALL_ApproxMVBB_SOURCE
         ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/ComputeApproxMVBB.hpp
         ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/ContainerFunctions.hpp
         ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/ConvexHull2D.hpp
+        ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/ConvexHull3D.hpp
+        ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/DirectionCache.hpp
+        ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/ExactMVBB.hpp
         ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/GreatestCommonDivisor.hpp
+        ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/GridDirections.hpp
+        ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/IncrementalMVBB.hpp
         ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/KdTree.hpp
         ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/KdTreeXml.hpp
         ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/MakeCoordinateSystem.hpp
+        ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/MVBBWorkspace.hpp
         ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/MinAreaRectangle.hpp
         ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/OOBB.hpp
+        ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/PointCloudFile.hpp
         ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/PointFunctions.hpp
         ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/ProjectedPointSet.hpp
         ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/RandomGenerators.hpp
+        ${ApproxMVBB_ROOT_DIR}/include/ApproxMVBB/SoAPointsView.hpp
 
         ${ApproxMVBB_DIAM_INC}
         ${ApproxMVBB_GEOMPRED_INC}
@@ -31,4 +31,7 @@ include(FindPackageHandleStandardArgs)
 find_package_handle_standard_args("ApproxMVBBSource" DEFAULT_MSG ApproxMVBB_INC_DIR ApproxMVBB_SRC_DIR ApproxMVBB_CMAKE_DIR)
 
 mark_as_advanced( ApproxMVBB_FORCE_MSGLOG_LEVEL)
-set(ApproxMVBB_FORCE_MSGLOG_LEVEL "-1" CACHE STRING "Force the message log level (0-3), -1 = use debug/release settings in LogDefines.hpp!")
\ No newline at end of file
+set(ApproxMVBB_FORCE_MSGLOG_LEVEL "-1" CACHE STRING "Force the message log level (0-3), -1 = use debug/release settings in LogDefines.hpp!")
+
+mark_as_advanced( ApproxMVBB_PREC)
+set(ApproxMVBB_PREC "double" CACHE STRING "Floating point type of the library (double or float), robust predicates and the distances of the diameter estimation are always evaluated in double (on float coordinates)")
\ No newline at end of file
@@ -10,9 +10,11 @@
 #define ApproxMVBB_Diameter_EstimateDiameter_hpp
 
 #include "ApproxMVBB/Diameter/TypeSegment.hpp"
+#include "ApproxMVBB/Diameter/Utils/alloc.hpp"
 #include "ApproxMVBB/RandomGenerators.hpp"
 
 #include <random>
+#include <vector>
 
 namespace ApproxMVBB
 {
@@ -28,6 +30,17 @@ namespace ApproxMVBB
         {
         }
 
+        ~DiameterEstimator();
+
+        DiameterEstimator(const DiameterEstimator&) = delete;
+        DiameterEstimator& operator=(const DiameterEstimator&) = delete;
+
+        /** Reseed the random generator, such that the estimator behaves like a newly constructed one */
+        void seed(std::size_t seed)
+        {
+            m_gen.seed(seed);
+        }
+
         /** Raw function to estimate the diameter of a point cloud
     *   @param theDiam returns the diameter info
     *   @param theList input point cloud (look at example how to call this function)
@@ -45,6 +58,57 @@ namespace ApproxMVBB
                                 const int dim,
                                 double epsilon);
 
+        /** Estimate the diameter of 3d points given by their coordinate arrays.
+    *   The points are copied into a scratch buffer (x, y and z in separate arrays) which is
+    *   reordered in place instead of swapping pointers, such that all scans run over contiguous
+    *   memory with vectorized kernels (see estimateDiameter for the parameters).
+    *   The estimated diameter is identical to the one of estimateDiameter with `dim = 3`.
+    *   @param index1,index2 return the indices of the two extremities
+    *   @param x,y,z the coordinates of the first point, the coordinates of point #i are
+               `x[i*stride]`, `y[i*stride]` and `z[i*stride]` (e.g. three separate arrays with
+               `stride = 1` or contiguous points with `y = x+1`, `z = x+2` and `stride = 3`)
+    */
+        double estimateDiameter3D(unsigned int* index1,
+                                  unsigned int* index2,
+                                  double const* x,
+                                  double const* y,
+                                  double const* z,
+                                  const unsigned int size,
+                                  const unsigned int stride,
+                                  double epsilon);
+
+        /** Estimate the diameter of 3d points in float (see above).
+    *   The scratch buffer stores the coordinates in float, the distances are computed in double.
+    */
+        double estimateDiameter3D(unsigned int* index1,
+                                  unsigned int* index2,
+                                  float const* x,
+                                  float const* y,
+                                  float const* z,
+                                  const unsigned int size,
+                                  const unsigned int stride,
+                                  double epsilon);
+
+        /** Estimate the diameter of 2d points given by their coordinate arrays (see estimateDiameter3D).
+    *   The estimated diameter is identical to the one of estimateDiameter with `dim = 2`.
+    */
+        double estimateDiameter2D(unsigned int* index1,
+                                  unsigned int* index2,
+                                  double const* x,
+                                  double const* y,
+                                  const unsigned int size,
+                                  const unsigned int stride,
+                                  double epsilon);
+
+        /** Estimate the diameter of 2d points in float (see estimateDiameter3D) */
+        double estimateDiameter2D(unsigned int* index1,
+                                  unsigned int* index2,
+                                  float const* x,
+                                  float const* y,
+                                  const unsigned int size,
+                                  const unsigned int stride,
+                                  double epsilon);
+
     private:
         double estimateDiameterInOneList(Diameter::TypeSegment* theDiam,
                                          double const** theList,
@@ -53,6 +117,15 @@ namespace ApproxMVBB
                                          const int dim,
                                          double _epsilon_);
 
+        template<unsigned int Dim, typename Scalar>
+        double estimateDiameterContiguous(unsigned int* index1,
+                                          unsigned int* index2,
+                                          const Scalar* const* coordinates,
+                                          const unsigned int size,
+                                          const unsigned int stride,
+                                          double epsilon,
+                                          std::vector<Scalar>& scratch);
+
         /** some settings from the original code ================================*/
         /** verbose when reducing*/
         int _verbose_when_reducing_ = 0;
@@ -178,6 +251,14 @@ namespace ApproxMVBB
 
         RandomGenerators::DefaultRandomGen m_gen;  ///< Random number generator
 
+        /** List of double normals, the allocated memory is reused over calls */
+        Diameter::TypeListOfSegments m_doubleNormals{0, 0, nullptr};
+
+        /** Scratch copy of the points for estimateDiameter3D/2D (coordinate arrays) and their indices */
+        std::vector<double> m_coordinates;
+        std::vector<float> m_coordinatesFloat;
+        std::vector<unsigned int> m_indices;
+
         /** TODO: ugly cast, I dont want to change the estimater code */
         int getRandomInt(unsigned int min, unsigned int max)
         {
@@ -0,0 +1,234 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#ifndef ApproxMVBB_Diameter_Utils_scan_hpp
+#define ApproxMVBB_Diameter_Utils_scan_hpp
+
+#include <algorithm>
+#include <vector>
+
+#include "ApproxMVBB/Config/Config.hpp"
+#include ApproxMVBB_TypeDefs_INCLUDE_FILE
+
+#if defined(ApproxMVBB_OPENMP_SUPPORT) && defined(_OPENMP)
+#    include <omp.h>
+#endif
+
+namespace ApproxMVBB
+{
+    namespace Diameter
+    {
+        /* scans over the points
+
+   The values of the points (distance to a point, scalar product
+   with a segment) are computed blockwise by `values(i, n, buffer)`
+   for the points #i to #i+n-1, such that contiguous point storage
+   can be processed with vectorized kernels.
+   Only blocks whose maximal value exceeds the current maximum
+   (or threshold) are searched point by point.
+
+   For more than _parallelScanMinSize_ points the scans are
+   distributed over the threads (OpenMP) in chunks.
+   The results are identical to the serial loops, thus independent
+   of the number of threads:
+   - the farthest point is the first point with the maximal value,
+     the maxima of the chunks are merged in ascending order,
+   - the points outside a sphere are collected per chunk in ascending
+     order and swapped to the beginning of the list afterwards, in the
+     same order as the serial loop does (the test of point #i does not
+     depend on the swaps of the points before it).
+*/
+
+        constexpr int _scanBlockSize_       = 256;
+        constexpr int _parallelScanMinSize_ = 1 << 15;
+
+        inline int _MaxThreads()
+        {
+#if defined(ApproxMVBB_OPENMP_SUPPORT) && defined(ApproxMVBB_OPENMP_USE_NTHREADS)
+            return ApproxMVBB_OPENMP_NTHREADS;
+#elif defined(ApproxMVBB_OPENMP_SUPPORT) && defined(_OPENMP)
+            return omp_get_max_threads();
+#else
+            return 1;
+#endif
+        }
+
+        /* number of chunks for the points [#first,#last]
+ */
+        inline int _ScanChunks(const int first, const int last)
+        {
+            int n        = last - first + 1;
+            int nThreads = _MaxThreads();
+            if(nThreads <= 1 || n <= _parallelScanMinSize_)
+                return (1);
+            return (std::min(4 * nThreads, n / (_parallelScanMinSize_ / 4)));
+        }
+
+        /* calls visit(i, n, buffer, max) for the blocks of points [#begin,#end)
+   in ascending order, with the values of the points #i to #i+n-1 in `buffer`
+   and their maximum `max`
+*/
+        template<typename Values, typename Visit>
+        inline void _ScanBlocks(const int begin, const int end, const Values& values, Visit& visit)
+        {
+            double buffer[_scanBlockSize_];
+            for(int b = begin; b < end; b += _scanBlockSize_)
+            {
+                int n = std::min(_scanBlockSize_, end - b);
+                values(b, n, buffer);
+                visit(b, n, buffer, Eigen::Map<const Eigen::ArrayXd>(buffer, n).maxCoeff());
+            }
+        }
+
+        /* first point #i in [#first,#last] with a value > *maxValue
+   and maximal value, *maxValue is updated,
+   returns #index if there is no such point
+*/
+        template<typename Values>
+        int _FirstMaximalPoint(const int first, const int last, int index, double* maxValue, const Values& values)
+        {
+            const int nChunks = _ScanChunks(first, last);
+            if(nChunks <= 1)
+            {
+                double max = *maxValue;
+                auto visit = [&max, &index](int b, int n, const double* buffer, double blockMax) {
+                    if(blockMax > max)
+                    {
+                        for(int k = 0; k < n; k++)
+                        {
+                            if(buffer[k] > max)
+                            {
+                                max   = buffer[k];
+                                index = b + k;
+                            }
+                        }
+                    }
+                };
+                _ScanBlocks(first, last + 1, values, visit);
+                *maxValue = max;
+                return (index);
+            }
+
+            std::vector<double> maxima(nChunks, *maxValue);
+            std::vector<int> found(nChunks, index);
+            long long int nPoints = last - first + 1;
+
+            // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+            #pragma omp parallel for schedule(dynamic) ApproxMVBB_OPENMP_NUMTHREADS
+#endif
+            // clang-format on
+            for(int c = 0; c < nChunks; c++)
+            {
+                double max = maxima[c];
+                int i0     = found[c];
+                auto visit = [&max, &i0](int b, int n, const double* buffer, double blockMax) {
+                    if(blockMax > max)
+                    {
+                        for(int k = 0; k < n; k++)
+                        {
+                            if(buffer[k] > max)
+                            {
+                                max = buffer[k];
+                                i0  = b + k;
+                            }
+                        }
+                    }
+                };
+                _ScanBlocks(first + static_cast<int>(nPoints * c / nChunks),
+                            first + static_cast<int>(nPoints * (c + 1) / nChunks),
+                            values,
+                            visit);
+                maxima[c] = max;
+                found[c]  = i0;
+            }
+
+            for(int c = 0; c < nChunks; c++)
+            {
+                if(maxima[c] > *maxValue)
+                {
+                    *maxValue = maxima[c];
+                    index     = found[c];
+                }
+            }
+            return (index);
+        }
+
+        /* put the points in [#first,#last] with a value > threshold
+   at the beginning of the list with swap(i, j),
+   returns the index of the last point outside (#first-1 if none)
+*/
+        template<typename Values, typename Swap>
+        int _PartitionOutsidePoints(
+            const int first, const int last, const double threshold, const Values& values, const Swap& swap)
+        {
+            int index         = first - 1;
+            const int nChunks = _ScanChunks(first, last);
+            if(nChunks <= 1)
+            {
+                auto visit = [&index, threshold, &swap](int b, int n, const double* buffer, double blockMax) {
+                    if(blockMax > threshold)
+                    {
+                        for(int k = 0; k < n; k++)
+                        {
+                            if(buffer[k] > threshold)
+                            {
+                                index++;
+                                swap(index, b + k);
+                            }
+                        }
+                    }
+                };
+                _ScanBlocks(first, last + 1, values, visit);
+                return (index);
+            }
+
+            std::vector<std::vector<int>> outside(nChunks);
+            long long int nPoints = last - first + 1;
+
+            // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+            #pragma omp parallel for schedule(dynamic) ApproxMVBB_OPENMP_NUMTHREADS
+#endif
+            // clang-format on
+            for(int c = 0; c < nChunks; c++)
+            {
+                std::vector<int>& chunk = outside[c];
+                auto visit              = [&chunk, threshold](int b, int n, const double* buffer, double blockMax) {
+                    if(blockMax > threshold)
+                    {
+                        for(int k = 0; k < n; k++)
+                        {
+                            if(buffer[k] > threshold)
+                            {
+                                chunk.push_back(b + k);
+                            }
+                        }
+                    }
+                };
+                _ScanBlocks(first + static_cast<int>(nPoints * c / nChunks),
+                            first + static_cast<int>(nPoints * (c + 1) / nChunks),
+                            values,
+                            visit);
+            }
+
+            for(auto& chunk : outside)
+            {
+                for(int i : chunk)
+                {
+                    index++;
+                    swap(index, i);
+                }
+            }
+            return (index);
+        }
+    }  // namespace Diameter
+}  // namespace ApproxMVBB
+
+#endif
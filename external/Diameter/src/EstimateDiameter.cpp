@@ -7,12 +7,14 @@
 //  file, You can obtain one at http://mozilla.org/MPL/2.0/.
 // ========================================================================================
 
+#include <algorithm>
 #include <limits>
 
 #include "ApproxMVBB/Config/Config.hpp"
 #include ApproxMVBB_TypeDefs_INCLUDE_FILE
 #include "ApproxMVBB/Diameter/EstimateDiameter.hpp"
 #include "ApproxMVBB/Diameter/Utils/alloc.hpp"
+#include "ApproxMVBB/Diameter/Utils/scan.hpp"
 #include "ApproxMVBB/Diameter/Utils/util.hpp"
 
 #ifdef __clang__
@@ -24,6 +26,201 @@
 
 namespace ApproxMVBB
 {
+    namespace
+    {
+        /** `Dim` (2 or 3) dimensional points in separate coordinate arrays, which are reordered in place
+            (see estimateDiameter3D). The coordinates are stored in `Scalar` and the values are computed
+            in double. The kernels compute the values of a block of points with the same operations
+            as Diameter::_SquareDistance and Diameter::_ScalarProduct (bit-identical) */
+        template<typename Scalar, unsigned int Dim>
+        struct PointArrays
+        {
+            using ArrayMap  = Eigen::Map<const Eigen::Array<Scalar, Eigen::Dynamic, 1>>;
+            using ValuesMap = Eigen::Map<Eigen::ArrayXd>;
+
+            Scalar* m_coordinates[3];  ///< Coordinate arrays (the third one is unused in 2d).
+            unsigned int* m_indices;
+
+            inline void swap(const int i, const int j) const
+            {
+                for(unsigned int k = 0; k < Dim; ++k)
+                {
+                    std::swap(m_coordinates[k][i], m_coordinates[k][j]);
+                }
+                std::swap(m_indices[i], m_indices[j]);
+            }
+
+            inline void get(const int i, double* p) const
+            {
+                for(unsigned int k = 0; k < Dim; ++k)
+                {
+                    p[k] = m_coordinates[k][i];
+                }
+            }
+
+            /** Square distance of the point #i to the point `ref` */
+            inline double squareDistance(const int i, const double* ref) const
+            {
+                double p[3];
+                get(i, p);
+                double d = (p[0] - ref[0]) * (p[0] - ref[0]);
+                for(unsigned int k = 1; k < Dim; ++k)
+                {
+                    d += (p[k] - ref[k]) * (p[k] - ref[k]);
+                }
+                return d;
+            }
+
+            /** Square distances of the points #b to #b+n-1 to the point `ref` */
+            inline void squareDistances(const int b, const int n, const double* ref, double* values) const
+            {
+                auto x = coordinates(0, b, n);
+                auto y = coordinates(1, b, n);
+                if(Dim == 2)
+                {
+                    ValuesMap(values, n) = (x - ref[0]).square() + (y - ref[1]).square();
+                }
+                else
+                {
+                    auto z               = coordinates(2, b, n);
+                    ValuesMap(values, n) = (x - ref[0]).square() + (y - ref[1]).square() + (z - ref[2]).square();
+                }
+            }
+
+            /** Dot products MA.MB of the points M = #b to #b+n-1 */
+            inline void scalarProducts(const int b, const int n, const double* a, const double* c, double* values) const
+            {
+                auto x = coordinates(0, b, n);
+                auto y = coordinates(1, b, n);
+                if(Dim == 2)
+                {
+                    ValuesMap(values, n) = (x - a[0]) * (x - c[0]) + (y - a[1]) * (y - c[1]);
+                }
+                else
+                {
+                    auto z               = coordinates(2, b, n);
+                    ValuesMap(values, n) = (x - a[0]) * (x - c[0]) + (y - a[1]) * (y - c[1]) + (z - a[2]) * (z - c[2]);
+                }
+            }
+
+            /** Coordinate `k` of the points #b to #b+n-1 in double (an expression, returned by value) */
+            inline auto coordinates(const unsigned int k, const int b, const int n) const
+            {
+                return ArrayMap(m_coordinates[k] + b, n).template cast<double>();
+            }
+        };
+
+        /** Segment between two points of PointArrays, the extremities are copied as the points move */
+        struct Segment
+        {
+            double m_e1[3];
+            double m_e2[3];
+            unsigned int m_i1       = 0;
+            unsigned int m_i2       = 0;
+            double m_squareDiameter = std::numeric_limits<double>::lowest();
+        };
+
+        /** Dot product MA.MB of the point `m` and the extremities of `seg` (see Diameter::_ScalarProduct) */
+        template<unsigned int Dim>
+        inline double scalarProduct(const double* m, const Segment& seg)
+        {
+            double s = (seg.m_e1[0] - m[0]) * (seg.m_e2[0] - m[0]);
+            for(unsigned int k = 1; k < Dim; ++k)
+            {
+                s += (seg.m_e1[k] - m[k]) * (seg.m_e2[k] - m[k]);
+            }
+            return s;
+        }
+
+        /** Index of the last point in [#first,#last] outside the sphere with diameter `squareDiameter`
+            centered at `seg` (see Diameter::_LastPointOutsideSphereWithDiameter without reduction) */
+        template<typename Scalar, unsigned int Dim>
+        int lastPointOutsideSphere(const Segment& seg,
+                                   const double squareDiameter,
+                                   const PointArrays<Scalar, Dim>& p,
+                                   const int first,
+                                   const int last)
+        {
+            double threshold = 0.0;
+            if(squareDiameter > seg.m_squareDiameter)
+            {
+                threshold = 0.25 * (squareDiameter - seg.m_squareDiameter);
+            }
+            return Diameter::_PartitionOutsidePoints(
+                first,
+                last,
+                threshold,
+                [&p, &seg](const int b, const int n, double* values) {
+                    p.scalarProducts(b, n, seg.m_e1, seg.m_e2, values);
+                },
+                [&p](const int i, const int j) { p.swap(i, j); });
+        }
+
+        /** Iterative search of a double normal starting at point #i (see Diameter::_MaximalSegmentInOneList) */
+        template<typename Scalar, unsigned int Dim>
+        double maximalSegment(Segment* seg, int i, const PointArrays<Scalar, Dim>& p, int* first, const int last)
+        {
+            int f = *first;
+            double ref[3];
+            double d, dprevious;
+
+            seg->m_squareDiameter = std::numeric_limits<double>::lowest();
+            if(f == last)
+            {
+                p.get(i, seg->m_e1);
+                p.get(i, seg->m_e2);
+                seg->m_i1 = seg->m_i2 = p.m_indices[i];
+                return (0.0);
+            }
+
+            do
+            {
+                dprevious = seg->m_squareDiameter;
+
+                /* point #i will be compared against all other points
+           reject it at the beginning of the list
+           do not consider it in the future
+        */
+                p.get(i, ref);
+                unsigned int refIndex = p.m_indices[i];
+                p.swap(f, i);
+                f++;
+
+                /* find the furthest point from 'ref'
+         */
+                if(f > last)
+                {
+                    break;
+                }
+                d = p.squareDistance(f, ref);
+                i = Diameter::_FirstMaximalPoint(
+                    f + 1, last, f, &d, [&p, &ref](const int b, const int n, double* values) {
+                        p.squareDistances(b, n, ref, values);
+                    });
+                if(d > seg->m_squareDiameter)
+                {
+                    std::copy(ref, ref + Dim, seg->m_e1);
+                    p.get(i, seg->m_e2);
+                    seg->m_i1             = refIndex;
+                    seg->m_i2             = p.m_indices[i];
+                    seg->m_squareDiameter = d;
+                }
+
+            } while(seg->m_squareDiameter > dprevious && f <= last);
+
+            *first = f;
+            return (seg->m_squareDiameter);
+        }
+    }  // namespace
+
+    DiameterEstimator::~DiameterEstimator()
+    {
+        if(m_doubleNormals.nalloc > 0)
+        {
+            free(m_doubleNormals.seg);
+        }
+    }
+
     double DiameterEstimator::estimateDiameter(Diameter::TypeSegment* theDiam,
                                                double const** theList,
                                                const int first,
@@ -39,6 +236,195 @@ namespace ApproxMVBB
         return this->estimateDiameterInOneList(theDiam, theList, first, last, dim, epsilon);
     }
 
+    template<unsigned int Dim, typename Scalar>
+    double DiameterEstimator::estimateDiameterContiguous(unsigned int* index1,
+                                                         unsigned int* index2,
+                                                         const Scalar* const* coordinates,
+                                                         const unsigned int size,
+                                                         const unsigned int stride,
+                                                         double epsilon,
+                                                         std::vector<Scalar>& scratch)
+    {
+        /* same steps as estimateDiameterInOneList with the settings of
+       estimateDiameter (no reduction, no reduction of Q, no tight bounds)
+    */
+        int index, index1Outside, index2Outside;
+        double bound, newEstimate, upperBound, upperSquareDiameter;
+
+        *index1 = *index2 = 0;
+        if(size == 0)
+            return (-1.0);
+
+        scratch.resize(Dim * static_cast<std::size_t>(size));
+        m_indices.resize(size);
+        PointArrays<Scalar, Dim> p{{nullptr, nullptr, nullptr}, m_indices.data()};
+        for(unsigned int k = 0; k < Dim; ++k)
+        {
+            p.m_coordinates[k] = scratch.data() + k * static_cast<std::size_t>(size);
+        }
+        for(unsigned int i = 0; i < size; ++i)
+        {
+            std::size_t offset = static_cast<std::size_t>(i) * stride;
+            for(unsigned int k = 0; k < Dim; ++k)
+            {
+                p.m_coordinates[k][i] = coordinates[k][offset];
+            }
+            p.m_indices[i] = i;
+        }
+
+        int f = 0;
+        int l = static_cast<int>(size) - 1;
+        if(f == l)
+            return (0.0);
+
+        Segment theDiam, theSeg;
+        double m[3];
+
+        index = getRandomInt(f, l);
+        for(;;)
+        {
+            /* find a double normal
+         */
+            newEstimate = maximalSegment(&theSeg, index, p, &f, l);
+            if(newEstimate <= theDiam.m_squareDiameter)
+            {
+                break;
+            }
+            theDiam = theSeg;
+
+            /* find the farthest point outside the sphere
+         */
+            double maxdiff = 0.0;
+            index          = Diameter::_FirstMaximalPoint(
+                f, l, f - 1, &maxdiff, [&p, &theDiam](const int b, const int n, double* values) {
+                    p.scalarProducts(b, n, theDiam.m_e1, theDiam.m_e2, values);
+                });
+
+            /* stopping conditions (see estimateDiameterInOneList)
+         */
+            if(index < f)
+            {
+                *index1 = theDiam.m_i1;
+                *index2 = theDiam.m_i2;
+                return (theDiam.m_squareDiameter);
+            }
+
+            p.get(index, m);
+            bound = 4.0 * scalarProduct<Dim>(m, theDiam) + theDiam.m_squareDiameter;
+            if(1.0 + 4.0 * scalarProduct<Dim>(m, theDiam) / theDiam.m_squareDiameter < (1.0 + epsilon) * (1.0 + epsilon))
+            {
+                *index1 = theDiam.m_i1;
+                *index2 = theDiam.m_i2;
+                return (bound);
+            }
+        }
+
+        *index1 = theDiam.m_i1;
+        *index2 = theDiam.m_i2;
+
+        /* points outside the sphere of the diameter
+     */
+        index = lastPointOutsideSphere(theDiam, theDiam.m_squareDiameter, p, f, l);
+        if(index < f)
+        {
+            return (theDiam.m_squareDiameter);
+        }
+
+        /* do you have enough precision?
+     */
+        index2Outside       = index;
+        upperSquareDiameter = theDiam.m_squareDiameter * (1.0 + epsilon) * (1.0 + epsilon);
+        index1Outside       = lastPointOutsideSphere(theDiam, upperSquareDiameter, p, f, index2Outside);
+        if(index1Outside < f)
+        {
+            p.get(f, m);
+            upperBound = 4.0 * scalarProduct<Dim>(m, theDiam) + theDiam.m_squareDiameter;
+            for(int k = f + 1; k <= index2Outside; k++)
+            {
+                p.get(k, m);
+                bound = 4.0 * scalarProduct<Dim>(m, theDiam) + theDiam.m_squareDiameter;
+                if(upperBound < bound)
+                    upperBound = bound;
+            }
+            return (upperBound);
+        }
+        upperBound = upperSquareDiameter;
+
+        /* exhautive search
+
+       comparison of points from #f to #index1Outside
+       against all others points
+    */
+        for(int i = f; i <= index1Outside; i++)
+        {
+            p.get(i, m);
+            newEstimate = theDiam.m_squareDiameter;
+            int j       = Diameter::_FirstMaximalPoint(
+                i + 1, l, -1, &newEstimate, [&p, &m](const int b, const int n, double* values) {
+                    p.squareDistances(b, n, m, values);
+                });
+            if(j >= 0)
+            {
+                *index1                  = p.m_indices[i];
+                *index2                  = p.m_indices[j];
+                theDiam.m_squareDiameter = newEstimate;
+                if(newEstimate > upperBound)
+                    upperBound = newEstimate;
+            }
+        }
+        return (upperBound);
+    }
+
+    double DiameterEstimator::estimateDiameter3D(unsigned int* index1,
+                                                 unsigned int* index2,
+                                                 double const* x,
+                                                 double const* y,
+                                                 double const* z,
+                                                 const unsigned int size,
+                                                 const unsigned int stride,
+                                                 double epsilon)
+    {
+        const double* coordinates[3] = {x, y, z};
+        return estimateDiameterContiguous<3>(index1, index2, coordinates, size, stride, epsilon, m_coordinates);
+    }
+
+    double DiameterEstimator::estimateDiameter3D(unsigned int* index1,
+                                                 unsigned int* index2,
+                                                 float const* x,
+                                                 float const* y,
+                                                 float const* z,
+                                                 const unsigned int size,
+                                                 const unsigned int stride,
+                                                 double epsilon)
+    {
+        const float* coordinates[3] = {x, y, z};
+        return estimateDiameterContiguous<3>(index1, index2, coordinates, size, stride, epsilon, m_coordinatesFloat);
+    }
+
+    double DiameterEstimator::estimateDiameter2D(unsigned int* index1,
+                                                 unsigned int* index2,
+                                                 double const* x,
+                                                 double const* y,
+                                                 const unsigned int size,
+                                                 const unsigned int stride,
+                                                 double epsilon)
+    {
+        const double* coordinates[2] = {x, y};
+        return estimateDiameterContiguous<2>(index1, index2, coordinates, size, stride, epsilon, m_coordinates);
+    }
+
+    double DiameterEstimator::estimateDiameter2D(unsigned int* index1,
+                                                 unsigned int* index2,
+                                                 float const* x,
+                                                 float const* y,
+                                                 const unsigned int size,
+                                                 const unsigned int stride,
+                                                 double epsilon)
+    {
+        const float* coordinates[2] = {x, y};
+        return estimateDiameterContiguous<2>(index1, index2, coordinates, size, stride, epsilon, m_coordinatesFloat);
+    }
+
     double DiameterEstimator::estimateDiameterInOneList(Diameter::TypeSegment* theDiam,
                                                         double const** theList,
                                                         const int first,
@@ -56,7 +442,8 @@ namespace ApproxMVBB
         int newEstimateIsSmallerThanCurrentEstimate;
         TypeSegment theSeg;
 
-        TypeListOfSegments theDoubleNormals;
+        // reuse the allocated list of double normals over calls
+        TypeListOfSegments& theDoubleNormals = m_doubleNormals;
 
         double newEstimate;
 
@@ -80,9 +467,7 @@ namespace ApproxMVBB
 
         double upperSquareDiameter = 0.0;
 
-        theDoubleNormals.n      = 0;
-        theDoubleNormals.nalloc = 0;
-        theDoubleNormals.seg    = nullptr;
+        theDoubleNormals.n = 0;
 
         theDiam->extremity1     = (double*)nullptr;
         theDiam->extremity2     = (double*)nullptr;
@@ -125,8 +510,6 @@ namespace ApproxMVBB
              */
                 if(_AddSegmentToList(&theSeg, &theDoubleNormals) != 1)
                 {
-                    if(theDoubleNormals.nalloc > 0)
-                        free(theDoubleNormals.seg);
                     return (-1.0);
                 }
 
@@ -151,8 +534,6 @@ namespace ApproxMVBB
             */
                 if(index < f)
                 {
-                    if(theDoubleNormals.nalloc > 0)
-                        free(theDoubleNormals.seg);
                     return (theDiam->squareDiameter);
                 }
 
@@ -187,8 +568,6 @@ namespace ApproxMVBB
                              theDiam->squareDiameter <
                    (1.0 + epsilon) * (1.0 + epsilon))
                 {
-                    if(theDoubleNormals.nalloc > 0)
-                        free(theDoubleNormals.seg);
                     return (bound);
                 }
             }
@@ -213,8 +592,6 @@ namespace ApproxMVBB
 
                 if(_AddSegmentToList(theDiam, &theDoubleNormals) != 1)
                 {
-                    if(theDoubleNormals.nalloc > 0)
-                        free(theDoubleNormals.seg);
                     return (-1.0);
                 }
 
@@ -272,8 +649,6 @@ namespace ApproxMVBB
     */
         if(index < f)
         {
-            if(theDoubleNormals.nalloc > 0)
-                free(theDoubleNormals.seg);
             return (theDiam->squareDiameter);
         }
 
@@ -288,8 +663,6 @@ namespace ApproxMVBB
     */
         if(index1 < f)
         {
-            if(theDoubleNormals.nalloc > 0)
-                free(theDoubleNormals.seg);
 
             upperBound = 4.0 * _ScalarProduct(theList[f], theDiam->extremity1, theList[f], theDiam->extremity2, dim) +
                          theDiam->squareDiameter;
@@ -529,8 +902,6 @@ namespace ApproxMVBB
             }
         }
 
-        if(theDoubleNormals.nalloc > 0)
-            free(theDoubleNormals.seg);
 
         /* exhautive search
 
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <limits>
 
+#include <ApproxMVBB/Diameter/Utils/scan.hpp>
 #include <ApproxMVBB/Diameter/Utils/util.hpp>
 
 #ifdef __clang__
@@ -116,16 +117,16 @@ namespace ApproxMVBB
 
                     if(dim == 3)
                     {
-                        for(i = first; i <= l; i++)
-                        {
-                            mamb = _ScalarProduct3D(theList[i], theSeg->extremity1, theList[i], theSeg->extremity2);
-                            if(mamb > maxThreshold)
-                            {
-                                index++;
-                                _SwapPoints(theList, index, i);
-                            }
-                        }
-                        return (index);
+                        return (_PartitionOutsidePoints(
+                            first,
+                            l,
+                            maxThreshold,
+                            [theList, theSeg](const int b, const int n, double* values) {
+                                for(int k = 0; k < n; k++)
+                                    values[k] = _ScalarProduct3D(
+                                        theList[b + k], theSeg->extremity1, theList[b + k], theSeg->extremity2);
+                            },
+                            [theList](const int a, const int b) { _SwapPoints(theList, a, b); }));
                     }
 
                     for(i = first; i <= l; i++)
@@ -983,16 +984,12 @@ namespace ApproxMVBB
 
                     if(dim == 3)
                     {
-                        for(i = first; i <= l; i++)
-                        {
-                            diff = _ScalarProduct3D(theList[i], theSeg->extremity1, theList[i], theSeg->extremity2);
-                            if(maxdiff < diff)
-                            {
-                                index   = i;
-                                maxdiff = diff;
-                            }
-                        }
-                        return (index);
+                        return (_FirstMaximalPoint(
+                            first, l, index, &maxdiff, [theList, theSeg](const int b, const int n, double* values) {
+                                for(int k = 0; k < n; k++)
+                                    values[k] = _ScalarProduct3D(
+                                        theList[b + k], theSeg->extremity1, theList[b + k], theSeg->extremity2);
+                            }));
                     }
 
                     for(i = first; i <= l; i++)
@@ -1285,17 +1282,10 @@ namespace ApproxMVBB
             if(dim == 3)
             {
                 dmax   = _SquareDistance3D(theList[f], ref);
-                *index = f;
-
-                for(i = f + 1; i <= l; i++)
-                {
-                    d = _SquareDistance3D(theList[i], ref);
-                    if(d > dmax)
-                    {
-                        dmax   = d;
-                        *index = i;
-                    }
-                }
+                *index = _FirstMaximalPoint(f + 1, l, f, &dmax, [theList, ref](const int b, const int n, double* values) {
+                    for(int k = 0; k < n; k++)
+                        values[k] = _SquareDistance3D(theList[b + k], ref);
+                });
                 return (dmax);
             }
 
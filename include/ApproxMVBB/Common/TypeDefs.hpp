@@ -22,7 +22,7 @@ namespace ApproxMVBB
 {
     struct GlobalConfigs
     {
-        using PREC = double;
+        using PREC = ApproxMVBB_PREC;
     };
 
 #define ApproxMVBB_DEFINE_MATRIX_TYPES            \
@@ -11,22 +11,476 @@
 #ifndef ApproxMVBB_ComputeApproxMVBB_hpp
 #define ApproxMVBB_ComputeApproxMVBB_hpp
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <exception>
+#include <limits>
 
 #include "ApproxMVBB/Common/LogDefines.hpp"
 #include "ApproxMVBB/Config/Config.hpp"
 #include ApproxMVBB_TypeDefs_INCLUDE_FILE
 #include "ApproxMVBB/Common/TypeDefs.hpp"
 #include ApproxMVBB_OOBB_INCLUDE_FILE
+#include "ApproxMVBB/ConvexHull3D.hpp"
 #include "ApproxMVBB/GreatestCommonDivisor.hpp"
+#include "ApproxMVBB/GridDirections.hpp"
+#include "ApproxMVBB/MakeCoordinateSystem.hpp"
+#include "ApproxMVBB/MVBBWorkspace.hpp"
 #include "ApproxMVBB/ProjectedPointSet.hpp"
 #include "ApproxMVBB/RandomGenerators.hpp"
 
+#if defined(ApproxMVBB_OPENMP_SUPPORT) && defined(_OPENMP)
+#    include <omp.h>
+#endif
+
 namespace ApproxMVBB
 {
     ApproxMVBB_DEFINE_MATRIX_TYPES;
     ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
 
+    /** Grid of samplePointsGrid */
+    enum class SampleGridMode
+    {
+        Square,       ///< `gridSize x gridSize` cells (`gridSize = sqrt(nPoints/2)`), bottom/top points in z.
+        Anisotropic,  ///< About `nPoints/2` cells shaped by the x/y extents of the box, bottom/top points in z.
+        SixFaces      ///< Anisotropic grids for all three axes: the bottom/top points towards all six faces.
+    };
+
+    /** Padding of the sample of samplePointsGrid if the grid has less points than requested
+        (empty cells). The strategies other than `Random` fall back to `Random` if they cannot fill the sample. */
+    enum class SamplePadding
+    {
+        Random,               ///< Uniformly random points (hit dense regions of clustered points repeatedly).
+        StratifiedReservoir,  ///< Same number of random points of each non-empty cell (one more pass over the points).
+        PoissonDisk,          ///< Random points with a minimal distance to all sample points.
+        FarthestPoint         ///< Farthest point sampling from a random candidate pool.
+    };
+
+    namespace details
+    {
+        /** Number of threads of the parallel regions (1 without OpenMP) */
+        inline unsigned int maxThreads()
+        {
+#if defined(ApproxMVBB_OPENMP_SUPPORT) && defined(ApproxMVBB_OPENMP_USE_NTHREADS)
+            return ApproxMVBB_OPENMP_NTHREADS;
+#elif defined(ApproxMVBB_OPENMP_SUPPORT) && defined(_OPENMP)
+            return static_cast<unsigned int>(omp_get_max_threads());
+#else
+            return 1;
+#endif
+        }
+
+        /** Minimal number of points per chunk of the parallel samplePointsGrid */
+        constexpr long long int sampleGridChunkSize()
+        {
+            return 1 << 16;
+        }
+
+        /** One grid of samplePointsGrid in the frame `K` of the box: the cells divide the box along
+            the axes `m_axes[0]` and `m_axes[1]` and store the bottom/top point along `m_axes[2]`. */
+        struct SampleGridLayout
+        {
+            ApproxMVBB_DEFINE_MATRIX_TYPES;
+            ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
+
+            std::array<unsigned int, 3> m_axes;  ///< Grid axes and the axis of the bottom/top points.
+            std::array<unsigned int, 2> m_size;  ///< Number of cells along the grid axes.
+            std::array<PREC, 2> m_cellSizeInv;   ///< Inverse cell size along the grid axes.
+            std::size_t m_offset;                ///< Index of the first cell.
+        };
+
+        /** Number of cells along both grid axes with about `nCells` cells (not more), such that the
+            cells are about square for the extents `extentX, extentY` */
+        inline std::array<unsigned int, 2> anisotropicGridSize(unsigned int nCells, PREC extentX, PREC extentY)
+        {
+            nCells         = std::max(nCells, 1U);
+            unsigned int x = nCells;
+            if(extentX <= 0)
+            {
+                x = 1;
+            }
+            else if(extentY > 0)
+            {
+                x = static_cast<unsigned int>(std::sqrt(static_cast<double>(nCells) * extentX / extentY));
+                x = std::max(std::min(x, nCells), 1U);
+            }
+            return {{x, nCells / x}};
+        }
+
+        /** Set up the grids of samplePointsGrid for `nPoints` samples in the box `oobb` (z-axis longest)
+            and returns the number of cells of all grids */
+        inline std::size_t makeSampleGridLayouts(std::array<SampleGridLayout, 3>& layouts,
+                                                 unsigned int& nLayouts,
+                                                 const unsigned int nPoints,
+                                                 const OOBB& oobb,
+                                                 SampleGridMode mode)
+        {
+            // SixFaces needs at least one cell (2 points) for each grid
+            if(mode == SampleGridMode::SixFaces && nPoints < 6)
+            {
+                mode = SampleGridMode::Anisotropic;
+            }
+
+            Vector3 extent     = oobb.extent();
+            nLayouts           = mode == SampleGridMode::SixFaces ? 3 : 1;
+            std::size_t nCells = 0;
+            for(unsigned int l = 0; l < nLayouts; ++l)
+            {
+                auto& layout  = layouts[l];
+                // The grid of the bottom/top points in z comes first
+                layout.m_axes = {{(l + 0) % 3, (l + 1) % 3, (l + 2) % 3}};
+
+                PREC extentX = extent(layout.m_axes[0]), extentY = extent(layout.m_axes[1]);
+                if(mode == SampleGridMode::Square)
+                {
+                    // total points = bottomPoints=gridSize^2  + topPoints=gridSize^2
+                    unsigned int gridSize =
+                        std::max(static_cast<unsigned int>(std::sqrt(static_cast<double>(nPoints) / 2.0)), 1U);
+                    layout.m_size = {{gridSize, gridSize}};
+                }
+                else
+                {
+                    layout.m_size = anisotropicGridSize(nPoints / (2 * nLayouts), extentX, extentY);
+                }
+
+                layout.m_cellSizeInv[0] = extentX > 0 ? layout.m_size[0] / extentX : 0;
+                layout.m_cellSizeInv[1] = extentY > 0 ? layout.m_size[1] / extentY : 0;
+                layout.m_offset         = nCells;
+                nCells += std::size_t(layout.m_size[0]) * layout.m_size[1];
+            }
+            return nCells;
+        }
+
+        /** Cell of the point `K_p` (in the frame of the box with the minimal point `minPoint`) in the grid `layout` */
+        inline std::size_t sampleGridCell(const SampleGridLayout& layout, const Vector3& K_p, const Vector3& minPoint)
+        {
+            using LongInt = long long int;
+            const auto ax = layout.m_axes[0], ay = layout.m_axes[1];
+            // get index in grid
+            LongInt x = static_cast<LongInt>((K_p(ax) - minPoint(ax)) * layout.m_cellSizeInv[0]);
+            LongInt y = static_cast<LongInt>((K_p(ay) - minPoint(ay)) * layout.m_cellSizeInv[1]);
+            // map to grid
+            x = std::max(std::min(LongInt(layout.m_size[0] - 1), x), 0LL);
+            y = std::max(std::min(LongInt(layout.m_size[1] - 1), y), 0LL);
+            return layout.m_offset + static_cast<std::size_t>(x + y * layout.m_size[0]);
+        }
+
+        /** Register the points `[begin,end)` in the grids `layouts` of samplePointsGrid (cells in `cells`):
+            each cell keeps the point with the highest and the lowest coordinate along the axis
+            `m_axes[2]`, the first of the points with equal coordinates */
+        template<typename Derived>
+        void addToSampleGrid(const MatrixBase<Derived>& points,
+                             typename Derived::Index begin,
+                             typename Derived::Index end,
+                             const OOBB& oobb,
+                             const std::array<SampleGridLayout, 3>& layouts,
+                             const unsigned int nLayouts,
+                             BottomTopPoints* cells)
+        {
+            Matrix33 A_KI(oobb.m_q_KI.matrix().transpose());
+            Vector3 K_p;
+
+            for(auto i = begin; i < end; ++i)
+            {
+                K_p = A_KI * points.col(i);
+                for(unsigned int l = 0; l < nLayouts; ++l)
+                {
+                    const auto& layout = layouts[l];
+                    PREC z             = K_p(layout.m_axes[2]);
+
+                    // Register points in grid
+                    // if z component of p is > pB.topZ  -> set new top point at pos
+                    // if z component of p is < pB.bottomZ    -> set new bottom point at pos
+                    auto& pB = cells[sampleGridCell(layout, K_p, oobb.m_minPoint)];
+
+                    if(pB.bottomIdx == 0)
+                    {
+                        pB.bottomIdx = pB.topIdx = i + 1;
+                        pB.bottomZ = pB.topZ = z;
+                    }
+                    else
+                    {
+                        if(pB.topZ < z)
+                        {
+                            pB.topIdx = i + 1;
+                            pB.topZ   = z;
+                        }
+                        else
+                        {
+                            if(pB.bottomZ > z)
+                            {
+                                pB.bottomIdx = i + 1;
+                                pB.bottomZ   = z;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        /** Merge the cell `b` into `a` (min/max reduction of addToSampleGrid):
+            the result is the same as registering the points of both cells in index order */
+        inline void mergeSampleGridCells(BottomTopPoints& a, const BottomTopPoints& b)
+        {
+            if(b.bottomIdx == 0)
+            {
+                return;
+            }
+            if(a.bottomIdx == 0)
+            {
+                a = b;
+                return;
+            }
+            if(b.topZ > a.topZ || (b.topZ == a.topZ && b.topIdx < a.topIdx))
+            {
+                a.topIdx = b.topIdx;
+                a.topZ   = b.topZ;
+            }
+            if(b.bottomZ < a.bottomZ || (b.bottomZ == a.bottomZ && b.bottomIdx < a.bottomIdx))
+            {
+                a.bottomIdx = b.bottomIdx;
+                a.bottomZ   = b.bottomZ;
+            }
+        }
+
+        /** Pads the sample `newPoints` (the first `k` columns are set) with uniformly random points */
+        template<typename Derived, typename IndexType>
+        void padSampleRandom(Matrix3Dyn& newPoints, IndexType& k, const MatrixBase<Derived>& points, std::size_t seed)
+        {
+            IndexType nPoints = newPoints.cols();
+            RandomGenerators::DefaultRandomGen gen(seed);
+            RandomGenerators::DefaultUniformUIntDistribution<typename std::make_unsigned<IndexType>::type> dis(
+                0, points.cols() - 1);
+            IndexType s;
+            while(k < nPoints)
+            {
+                s = dis(gen);
+                ApproxMVBB_MSGLOG_L2(s << ", ");
+                newPoints.col(k++) = points.col(s);
+            }
+        }
+
+        /** Pads the sample `newPoints` with the same number of random points of each non-empty cell of the
+            grid `layout` (`buffers.m_cells`): one more pass over the points fills a reservoir per cell
+            (Vitter's algorithm R), which are taken round robin (without the bottom/top points of the cells) */
+        template<typename Derived, typename IndexType>
+        void padSampleStratified(Matrix3Dyn& newPoints,
+                                 IndexType& k,
+                                 const MatrixBase<Derived>& points,
+                                 const OOBB& oobb,
+                                 const SampleGridLayout& layout,
+                                 SampleGridBuffers& buffers,
+                                 std::size_t seed)
+        {
+            const auto& cells  = buffers.m_cells;
+            IndexType nPoints  = newPoints.cols();
+            std::size_t nCells = std::size_t(layout.m_size[0]) * layout.m_size[1];
+            std::size_t nUsed  = std::count_if(cells.begin() + layout.m_offset,
+                                              cells.begin() + layout.m_offset + nCells,
+                                              [](const BottomTopPoints& c) { return c.bottomIdx != 0; });
+            nUsed = std::max(nUsed, std::size_t(1));
+
+            // Reservoir size: the share of each cell and its bottom/top point
+            std::size_t size = (static_cast<std::size_t>(nPoints - k) + nUsed - 1) / nUsed + 2;
+            auto& reservoirs = buffers.m_reservoirs;
+            auto& seen       = buffers.m_seen;
+            reservoirs.assign(nCells * size, 0);
+            seen.assign(nCells, 0);
+
+            RandomGenerators::DefaultRandomGen gen(seed);
+            Matrix33 A_KI(oobb.m_q_KI.matrix().transpose());
+            for(IndexType i = 0; i < points.cols(); ++i)
+            {
+                std::size_t c = sampleGridCell(layout, A_KI * points.col(i), oobb.m_minPoint) - layout.m_offset;
+                std::size_t s = seen[c]++;
+                if(s >= size)
+                {
+                    s = RandomGenerators::DefaultUniformUIntDistribution<std::size_t>(0, s)(gen);
+                }
+                if(s < size)
+                {
+                    reservoirs[c * size + s] = i;
+                }
+            }
+
+            for(std::size_t slot = 0; slot < size && k < nPoints; ++slot)
+            {
+                for(std::size_t c = 0; c < nCells && k < nPoints; ++c)
+                {
+                    const auto& cell = cells[layout.m_offset + c];
+                    if(slot >= seen[c])
+                    {
+                        continue;
+                    }
+                    IndexType i = reservoirs[c * size + slot];
+                    if(i + 1 != cell.topIdx && i + 1 != cell.bottomIdx)
+                    {
+                        ApproxMVBB_MSGLOG_L2(i << ", ");
+                        newPoints.col(k++) = points.col(i);
+                    }
+                }
+            }
+        }
+
+        /** Random candidate pool of `size` point indices (all points if there are not more) */
+        template<typename IndexType>
+        void samplePaddingCandidates(std::vector<IndexType>& candidates,
+                                     IndexType nPoints,
+                                     std::size_t size,
+                                     RandomGenerators::DefaultRandomGen& gen)
+        {
+            candidates.clear();
+            if(static_cast<std::size_t>(nPoints) <= size)
+            {
+                for(IndexType i = 0; i < nPoints; ++i)
+                {
+                    candidates.push_back(i);
+                }
+                return;
+            }
+            RandomGenerators::DefaultUniformUIntDistribution<typename std::make_unsigned<IndexType>::type> dis(
+                0, nPoints - 1);
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                candidates.push_back(static_cast<IndexType>(dis(gen)));
+            }
+        }
+
+        /** Pads the sample `newPoints` with random points which have at least the distance `r` to all
+            sample points (dart throwing, the sample points are stored in a hash grid with cell size `r`,
+            chained in `buffers.m_diskTable` and `buffers.m_diskNext`).
+            The radius starts at half the spacing of a regular grid with the missing points in the box
+            and is halved if a round of `30` candidates per missing point does not fill the sample. */
+        template<typename Derived, typename IndexType>
+        void padSamplePoissonDisk(Matrix3Dyn& newPoints,
+                                  IndexType& k,
+                                  const MatrixBase<Derived>& points,
+                                  const OOBB& oobb,
+                                  SampleGridBuffers& buffers,
+                                  std::size_t seed)
+        {
+            using LongInt     = long long int;
+            IndexType nPoints = newPoints.cols();
+
+            Vector3 extent = oobb.extent();
+            extent         = extent.cwiseMax(1e-6 * extent.maxCoeff());
+            PREC r         = 0.5 * std::cbrt(extent.prod() / static_cast<PREC>(nPoints - k));
+
+            // Hash table with at least twice as many slots as sample points
+            auto& table      = buffers.m_diskTable;
+            auto& next       = buffers.m_diskNext;
+            auto& grid       = buffers.m_diskPoints;
+            std::size_t mask = 1;
+            while(mask < 2 * static_cast<std::size_t>(nPoints))
+            {
+                mask <<= 1;
+            }
+            mask -= 1;
+
+            auto slot = [&](const Vector3& p, LongInt dx, LongInt dy, LongInt dz) {
+                auto x = static_cast<std::uint64_t>(static_cast<LongInt>(std::floor(p(0) / r)) + dx);
+                auto y = static_cast<std::uint64_t>(static_cast<LongInt>(std::floor(p(1) / r)) + dy);
+                auto z = static_cast<std::uint64_t>(static_cast<LongInt>(std::floor(p(2) / r)) + dz);
+                return static_cast<std::size_t>((x * 73856093ULL) ^ (y * 19349663ULL) ^ (z * 83492791ULL)) & mask;
+            };
+            auto insert = [&](const Vector3& p) {
+                std::size_t s = slot(p, 0, 0, 0);
+                next.push_back(table[s]);
+                table[s] = static_cast<int>(grid.size());
+                grid.push_back(p);
+            };
+            // Slots are shared by several cells, which only costs some distance tests
+            auto isFree = [&](const Vector3& p) {
+                for(LongInt dx = -1; dx <= 1; ++dx)
+                {
+                    for(LongInt dy = -1; dy <= 1; ++dy)
+                    {
+                        for(LongInt dz = -1; dz <= 1; ++dz)
+                        {
+                            for(int j = table[slot(p, dx, dy, dz)]; j >= 0; j = next[j])
+                            {
+                                if((p - grid[j]).squaredNorm() < r * r)
+                                {
+                                    return false;
+                                }
+                            }
+                        }
+                    }
+                }
+                return true;
+            };
+
+            RandomGenerators::DefaultRandomGen gen(seed);
+            auto& candidates = buffers.m_candidates;
+            for(unsigned int round = 0; round < 4 && k < nPoints; ++round, r *= 0.5)
+            {
+                table.assign(mask + 1, -1);
+                next.clear();
+                grid.clear();
+                for(IndexType i = 0; i < k; ++i)
+                {
+                    insert(newPoints.col(i));
+                }
+
+                samplePaddingCandidates(candidates, points.cols(), 30 * static_cast<std::size_t>(nPoints - k), gen);
+                for(std::size_t j = 0; j < candidates.size() && k < nPoints; ++j)
+                {
+                    Vector3 p = points.col(candidates[j]);
+                    if(isFree(p))
+                    {
+                        ApproxMVBB_MSGLOG_L2(candidates[j] << ", ");
+                        insert(p);
+                        newPoints.col(k++) = p;
+                    }
+                }
+            }
+        }
+
+        /** Pads the sample `newPoints` by greedy farthest point sampling: the candidate (of a random pool
+            of `16` candidates per missing point) farthest from all sample points is added until the
+            sample is full (or all candidates are in the sample) */
+        template<typename Derived, typename IndexType>
+        void padSampleFarthestPoint(Matrix3Dyn& newPoints,
+                                    IndexType& k,
+                                    const MatrixBase<Derived>& points,
+                                    SampleGridBuffers& buffers,
+                                    std::size_t seed)
+        {
+            IndexType nPoints = newPoints.cols();
+
+            RandomGenerators::DefaultRandomGen gen(seed);
+            auto& candidates = buffers.m_candidates;
+            samplePaddingCandidates(candidates, points.cols(), 16 * static_cast<std::size_t>(nPoints - k), gen);
+
+            // Squared distance of each candidate to the sample
+            auto& distance = buffers.m_distances;
+            distance.assign(candidates.size(), std::numeric_limits<PREC>::max());
+            auto update = [&](IndexType i) {
+                for(std::size_t j = 0; j < candidates.size(); ++j)
+                {
+                    distance[j] = std::min(distance[j], (points.col(candidates[j]) - newPoints.col(i)).squaredNorm());
+                }
+            };
+            for(IndexType i = 0; i < k; ++i)
+            {
+                update(i);
+            }
+
+            while(k < nPoints && !candidates.empty())
+            {
+                auto j = std::max_element(distance.begin(), distance.end()) - distance.begin();
+                if(distance[j] <= 0)
+                {
+                    break;
+                }
+                ApproxMVBB_MSGLOG_L2(candidates[j] << ", ");
+                newPoints.col(k) = points.col(candidates[j]);
+                update(k++);
+            }
+        }
+    }  // namespace details
+
     /*!
         We are given a point set, and (hopefully) a tight fitting
         bounding box. We compute a sample of the given size nPoints that
@@ -35,14 +489,23 @@ namespace ApproxMVBB
         the sample if necessary to get the desired size.
         This function changes the oobb and sets the z Axis to the greatest
         extent!
+        With `SampleGridMode::Square` the box is divided in a square grid of cells in x/y and the
+        bottom/top point in z of each cell is sampled. For elongated boxes most cells stay empty
+        and the sample is padded with random points, `SampleGridMode::Anisotropic` shapes the
+        cells by the extents instead and `SampleGridMode::SixFaces` samples the bottom/top points
+        of grids in all three axes (e.g. the extreme points towards the six faces of the box).
         @param nPoints needs to be greater or equal than 2
+        @param buffers are the grid buffers (reused over calls)
     */
     template<typename Derived>
     void samplePointsGrid(Matrix3Dyn& newPoints,
                           const MatrixBase<Derived>& points,
                           const unsigned int nPoints,
                           OOBB& oobb,
-                          std::size_t seed = ApproxMVBB::RandomGenerators::defaultSeed)
+                          details::SampleGridBuffers& buffers,
+                          std::size_t seed      = ApproxMVBB::RandomGenerators::defaultSeed,
+                          SampleGridMode mode   = SampleGridMode::Square,
+                          SamplePadding padding = SamplePadding::Random)
     {
         using IndexType = typename Derived::Index;
 
@@ -54,120 +517,208 @@ namespace ApproxMVBB
 
         newPoints.resize(3, nPoints);
 
-        // total points = bottomPoints=gridSize^2  + topPoints=gridSize^2
-        unsigned int gridSize = std::max(static_cast<unsigned int>(std::sqrt(static_cast<double>(nPoints) / 2.0)), 1U);
-
         // Set z-Axis to longest dimension
         // std::cout << oobb.m_minPoint.transpose() << std::endl;
         oobb.setZAxisLongest();
 
-        IndexType halfSampleSize = gridSize * gridSize;
-
-        struct BottomTopPoints
-        {
-            IndexType bottomIdx = 0;
-            PREC bottomZ;
-
-            IndexType topIdx = 0;
-            PREC topZ;
-        };
-
-        // grid of the bottom/top points in Z direction (indexed from 1 )
-        std::vector<BottomTopPoints> boundaryPoints(halfSampleSize);
-
-        using LongInt = long long int;
-        MyMatrix::Array2<LongInt> idx;  // Normalized P
-        // std::cout << oobb.extent() << std::endl;
-        // std::cout << oobb.m_minPoint.transpose() << std::endl;
-        Array2 dxdyInv = Array2(gridSize, gridSize) / oobb.extent().head<2>();  // in K Frame;
-        Vector3 K_p;
+        // grids of the bottom/top points (indexed from 1 )
+        std::array<details::SampleGridLayout, 3> layouts;
+        unsigned int nLayouts    = 0;
+        IndexType halfSampleSize = details::makeSampleGridLayouts(layouts, nLayouts, nPoints, oobb, mode);
 
-        Matrix33 A_KI(oobb.m_q_KI.matrix().transpose());
+        // Register points in grid: large point sets are split into chunks with one grid each
+        // (stored after each other in `boundaryPoints`), which are merged into the first grid.
+        // The merge gives the same grid as the serial loop, independent of the number of chunks.
+        using LongInt        = long long int;
+        IndexType size       = points.cols();
+        LongInt nChunks      = std::min(LongInt(details::maxThreads()), size / details::sampleGridChunkSize());
+        nChunks              = std::max(nChunks, 1LL);
+        auto& boundaryPoints = buffers.m_cells;
+        boundaryPoints.assign(nChunks * halfSampleSize, details::BottomTopPoints{});
 
-        // Register points in grid
-        IndexType size = points.cols();
-        for(IndexType i = 0; i < size; ++i)
+        // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+        #pragma omp parallel for schedule(static, 1) if(nChunks > 1) ApproxMVBB_OPENMP_NUMTHREADS
+#endif
+        // clang-format on
+        for(LongInt c = 0; c < nChunks; ++c)
         {
-            K_p = A_KI * points.col(i);
-            // get x index in grid
-            idx = ((K_p - oobb.m_minPoint).head<2>().array() * dxdyInv).template cast<LongInt>();
-            // map to grid
-            idx(0) = std::max(std::min(LongInt(gridSize - 1), idx(0)), 0LL);
-            idx(1) = std::max(std::min(LongInt(gridSize - 1), idx(1)), 0LL);
-            // std::cout << idx.transpose() << std::endl;
+            details::addToSampleGrid(points,
+                                     static_cast<IndexType>(c * size / nChunks),
+                                     static_cast<IndexType>((c + 1) * size / nChunks),
+                                     oobb,
+                                     layouts,
+                                     nLayouts,
+                                     boundaryPoints.data() + c * halfSampleSize);
+        }
 
-            // Register points in grid
-            // if z component of p is > pB.topZ  -> set new top point at pos
-            // if z component of p is < pB.bottomZ    -> set new bottom point at pos
-            auto& pB = boundaryPoints[idx(0) + idx(1) * gridSize];
+        for(LongInt c = 1; c < nChunks; ++c)
+        {
+            for(IndexType i = 0; i < halfSampleSize; ++i)
+            {
+                details::mergeSampleGridCells(boundaryPoints[i], boundaryPoints[c * halfSampleSize + i]);
+            }
+        }
 
-            if(pB.bottomIdx == 0)
+        // A point can be the bottom/top point in more than one grid (SixFaces),
+        // the marker is reset after the copy (only the selected points)
+        auto& marker   = buffers.m_marker;
+        auto& selected = buffers.m_selected;
+        if(nLayouts > 1 && marker.size() < static_cast<std::size_t>(size) + 1)
+        {
+            marker.resize(size + 1, 0);
+        }
+        selected.clear();
+        auto isNew = [&](IndexType idx) {
+            if(nLayouts == 1)
             {
-                pB.bottomIdx = pB.topIdx = i + 1;
-                pB.bottomZ = pB.topZ = K_p(2);
+                return true;
             }
-            else
+            if(marker[idx])
             {
-                if(pB.topZ < K_p(2))
-                {
-                    pB.topIdx = i + 1;
-                    pB.topZ   = K_p(2);
-                }
-                else
-                {
-                    if(pB.bottomZ > K_p(2))
-                    {
-                        pB.bottomIdx = i + 1;
-                        pB.bottomZ   = K_p(2);
-                    }
-                }
+                return false;
             }
-        }
+            marker[idx] = 1;
+            selected.push_back(idx);
+            return true;
+        };
 
         // Copy top and bottom points
         IndexType k = 0;
         ApproxMVBB_MSGLOG_L2("Sampled Points incides: [ ");
-            // k does not overflow -> 2* halfSampleSize = 2*gridSize*gridSize <=
-            // nPoints;
-            for(IndexType i = 0; i < halfSampleSize; ++i)
+        // k does not overflow -> 2* halfSampleSize <= nPoints;
+        for(IndexType i = 0; i < halfSampleSize; ++i)
         {
             if(boundaryPoints[i].bottomIdx != 0)
             {
-                // comment in if you want the top/bottom points of the grid
-                // Array3 a(i %
-                // gridSize,i/gridSize,oobb.m_maxPoint(2)-oobb.m_minPoint(2));
-                // a.head<2>()*=dxdyInv.inverse();
-                ApproxMVBB_MSGLOG_L2(boundaryPoints[i].topIdx - 1 << ", " << ((k % 30 == 0) ? "\n" : ""));
-                newPoints.col(k++) = points.col(boundaryPoints[i].topIdx - 1);  //  A_KI.transpose()*(oobb.m_minPoint + a.matrix()).eval() ;
-                if(boundaryPoints[i].topIdx != boundaryPoints[i].bottomIdx)
-                {
-                    // comment in if you want the bottom points of the grid
-                    // Array3 a(i % gridSize,i/gridSize,0);
-                    // a.head<2>()*=dxdyInv.inverse();
+                if(isNew(boundaryPoints[i].topIdx))
+                {
+                    ApproxMVBB_MSGLOG_L2(boundaryPoints[i].topIdx - 1 << ", " << ((k % 30 == 0) ? "\n" : ""));
+                    newPoints.col(k++) = points.col(boundaryPoints[i].topIdx - 1);
+                }
+                if(boundaryPoints[i].topIdx != boundaryPoints[i].bottomIdx && isNew(boundaryPoints[i].bottomIdx))
+                {
                     ApproxMVBB_MSGLOG_L2(boundaryPoints[i].bottomIdx - 1 << ", ");
-                    newPoints.col(k++) = points.col(boundaryPoints[i].bottomIdx - 1);  //  A_KI.transpose()*(oobb.m_minPoint + a.matrix()).eval() ;
+                    newPoints.col(k++) = points.col(boundaryPoints[i].bottomIdx - 1);
                 }
             }
         }
+        for(IndexType idx : selected)
+        {
+            marker[idx] = 0;
+        }
 
-        // Add random points!
-        // Random indices if too little points
+        // Pad the sample if the grid has too little points
         if(k < nPoints)
         {
-            RandomGenerators::DefaultRandomGen gen(seed);
-            RandomGenerators::DefaultUniformUIntDistribution<typename std::make_unsigned<IndexType>::type> dis(
-                0, points.cols() - 1);
-            IndexType s;
-            while(k < nPoints)
+            switch(padding)
             {
-                s = dis(gen);
-                ApproxMVBB_MSGLOG_L2(s << ", ");
-                newPoints.col(k++) = points.col(s);  //= Vector3(0,0,0);//
+                case SamplePadding::StratifiedReservoir:
+                    details::padSampleStratified(newPoints, k, points, oobb, layouts[0], buffers, seed);
+                    break;
+                case SamplePadding::PoissonDisk:
+                    details::padSamplePoissonDisk(newPoints, k, points, oobb, buffers, seed);
+                    break;
+                case SamplePadding::FarthestPoint:
+                    details::padSampleFarthestPoint(newPoints, k, points, buffers, seed);
+                    break;
+                default:
+                    break;
             }
+            details::padSampleRandom(newPoints, k, points, seed);
         }
         ApproxMVBB_MSGLOG_L2("]" << std::endl);
     }
 
+    template<typename Derived>
+    void samplePointsGrid(Matrix3Dyn& newPoints,
+                          const MatrixBase<Derived>& points,
+                          const unsigned int nPoints,
+                          OOBB& oobb,
+                          std::size_t seed      = ApproxMVBB::RandomGenerators::defaultSeed,
+                          SampleGridMode mode   = SampleGridMode::Square,
+                          SamplePadding padding = SamplePadding::Random)
+    {
+        details::SampleGridBuffers buffers;
+        samplePointsGrid(newPoints, points, nPoints, oobb, buffers, seed, mode, padding);
+    }
+
+    namespace details
+    {
+        /** Chooses the projection direction of each loop in optimizeMVBB:
+            the x-axis of the current box, or the y-axis if the x-axis is almost the same
+            as one of the last three directions (avoiding cycling in the choosen axis) */
+        class OptimizeDirectionCache
+        {
+        public:
+            ApproxMVBB_DEFINE_MATRIX_TYPES;
+
+            Vector3 next(const OOBB& oobb)
+            {
+                // Determine Direction (choose x or y axis)
+                Vector3 dir = oobb.getDirection(0);
+
+                // check against all cache values
+                for(unsigned int i = 0; i < 3 && i < m_loop; ++i)
+                {
+                    PREC dotp = std::abs(dir.dot(m_dirCache[i]));
+                    if(std::abs(dotp - 1.0) <= 1e-3)
+                    {
+                        // direction are almost the same as in the cache, choose another one
+                        dir = oobb.getDirection(1);
+                        break;
+                    }
+                }
+                // Write to cache and shift write idx
+                m_dirCache[m_cacheIdx] = dir;
+                m_cacheIdx             = (m_cacheIdx + 1) % 3;
+                m_loop                 = std::min(m_loop + 1, 3U);
+                return dir;
+            }
+
+        private:
+            unsigned int m_cacheIdx = 0;        ///< current write Idx into the cache
+            unsigned int m_loop     = 0;        ///< number of valid directions in the cache
+            std::array<Vector3, 3> m_dirCache;  ///< the last three directions
+        };
+
+        /** The loops of optimizeMVBB, `computeMVBB(dir)` computes the box in direction `dir`. */
+        template<typename ComputeMVBB>
+        OOBB optimizeMVBBLoops(OOBB oobb,
+                               ComputeMVBB&& computeMVBB,
+                               unsigned int nLoops,
+                               PREC volumeAcceptFactor,
+                               PREC minBoxExtent)
+        {
+            if(oobb.volume() == 0.0 || nLoops == 0)
+            {
+                return oobb;
+            }
+
+            // Define the volume lower bound above we accept a new volume as
+            PREC volumeAcceptTol = oobb.volume() * volumeAcceptFactor;
+
+            OptimizeDirectionCache dirCache;
+            Vector3 dir;
+            for(unsigned int loop = 0; loop < nLoops; ++loop)
+            {
+                dir = dirCache.next(oobb);
+
+                OOBB o = computeMVBB(dir);
+
+                // Expand box such the volume is not zero for points in a plane
+                o.expandToMinExtentAbsolute(minBoxExtent);
+
+                if(o.volume() < oobb.volume() && o.volume() > volumeAcceptTol)
+                {
+                    oobb = o;
+                }
+            }
+
+            return oobb;
+        }
+    }  // namespace details
+
     /*!
         Function to optimize oriented bounding box volume.
         Projecting nLoops times into the direction of the axis of the current oobb,
@@ -178,13 +729,57 @@ namespace ApproxMVBB
         @param minBoxExtent is the minmum extent direction a box must have, to make
         the volume not zero and comparable to other volumes
         which is useful for degenerated cases, such as all points in a surface 
+        @param proj is the projection (and its buffers) which is used for all loops
     */
+    template<typename Derived>
+    OOBB optimizeMVBB(const MatrixBase<Derived>& points,
+                      OOBB oobb,
+                      ProjectedPointSet& proj,
+                      unsigned int nLoops     = 10,
+                      PREC volumeAcceptFactor = 1e-6,
+                      PREC minBoxExtent       = 1e-12)
+    {
+        EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
+
+        return details::optimizeMVBBLoops(
+            oobb,
+            [&](const Vector3& dir) { return proj.computeMVBB(dir, points); },
+            nLoops,
+            volumeAcceptFactor,
+            minBoxExtent);
+    }
+
     template<typename Derived>
     OOBB optimizeMVBB(const MatrixBase<Derived>& points,
                       OOBB oobb,
                       unsigned int nLoops     = 10,
                       PREC volumeAcceptFactor = 1e-6,
                       PREC minBoxExtent       = 1e-12)
+    {
+        ProjectedPointSet proj;
+        return optimizeMVBB(points, oobb, proj, nLoops, volumeAcceptFactor, minBoxExtent);
+    }
+
+    /*!
+        Parallel version of optimizeMVBB which returns the identical box.
+        Each loop of optimizeMVBB depends on the box of the previous loop, however as long as
+        no new box is accepted, the directions of the next loops are known in advance.
+        The directions of the next `nSpeculative` loops are therefore projected in parallel
+        (assuming no box is accepted) and the serial loop is replayed on the results:
+        the results after the first accepted box are discarded.
+        Each speculative loop projects all points into its own ProjectedPointSet.
+        @param nSpeculative is the number of loops evaluated in parallel (0 = number of threads)
+        @param maxProjectionBytes caps `nSpeculative` such that the projections of all
+        speculative loops together need at most this many bytes (at least one loop runs)
+    */
+    template<typename Derived>
+    OOBB optimizeMVBBParallel(const MatrixBase<Derived>& points,
+                              OOBB oobb,
+                              unsigned int nLoops            = 10,
+                              PREC volumeAcceptFactor        = 1e-6,
+                              PREC minBoxExtent              = 1e-12,
+                              unsigned int nSpeculative      = 0,
+                              std::size_t maxProjectionBytes = std::size_t(1) << 30)
     {
         EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
 
@@ -193,75 +788,261 @@ namespace ApproxMVBB
             return oobb;
         }
 
-        // Define the volume lower bound above we accept a new volume as
-        PREC volumeAcceptTol = oobb.volume() * volumeAcceptFactor;
-
-        //    // Parallel Loop Start
-        //    ===============================================================
-        //    #ifdef ApproxMVBB_OPENMP_SUPPORT
-        //        #pragma omp declare reduction(volumeIsSmaller:OOBB: \
-        //                                            omp_in.volume()<omp_out.volume() ? omp_out=omp_in : omp_out \
-        //                                     ) initializer(omp_priv(omp_orig))
-        //
-        //        #pragma omp parallel for schedule(dynamic,1) \
-        //                                 shared(points) \
-        //                                 reduction(volumeIsSmaller:oobb) \
-        //                                 ApproxMVBB_OPENMP_NUMTHREADS
-        //
-        //
-        //        for(unsigned int parallelIdx = 0; parallelIdx < 12 ; ++parallelIdx )
-        //        {
-        //
-        //    #endif
-
-        unsigned int cacheIdx = 0;        // current write Idx into the cache
-        std::array<Vector3, 3> dirCache;  // save the last three directions (avoiding
-                                          // cycling in choosen axis)
-
-        Vector3 dir;
-        ProjectedPointSet proj;
-        for(unsigned int loop = 0; loop < nLoops; ++loop)
+        if(nSpeculative == 0)
+        {
+            nSpeculative = details::maxThreads();
+        }
+        const std::size_t projectionBytes = 2 * sizeof(PREC) * static_cast<std::size_t>(points.cols());
+        if(projectionBytes > 0)
         {
-            // Determine Direction (choose x or y axis)
-            // std::cout << oobb.m_q_KI.matrix() << std::endl;
-            dir = oobb.getDirection(0);
+            nSpeculative = static_cast<unsigned int>(
+                std::min<std::size_t>(nSpeculative, maxProjectionBytes / projectionBytes));
+        }
+        nSpeculative = std::max(std::min(nSpeculative, nLoops), 1U);
+
+        // Define the volume lower bound above we accept a new volume as
+        PREC volumeAcceptTol = oobb.volume() * volumeAcceptFactor;
 
-            // check against all cache values
-            for(unsigned char i = 0; i < 3 && i < loop; ++i)
+        StdVecAligned<ProjectedPointSet> projs(nSpeculative);
+        StdVecAligned<OOBB> boxes(nSpeculative);
+        std::vector<Vector3> dirs(nSpeculative);
+        std::vector<details::OptimizeDirectionCache> dirCaches(nSpeculative);
+        std::vector<std::exception_ptr> exceptions(nSpeculative);
+
+        details::OptimizeDirectionCache dirCache;
+        unsigned int loop = 0;
+        while(loop < nLoops)
+        {
+            // Directions of the next loops, if no new box is accepted
+            int n = static_cast<int>(std::min(nSpeculative, nLoops - loop));
+            for(int j = 0; j < n; ++j)
             {
-                PREC dotp = std::abs(dir.dot(dirCache[i]));  //
-                if(std::abs(dotp - 1.0) <= 1e-3)
+                dirs[j]       = dirCache.next(oobb);
+                dirCaches[j]  = dirCache;
+                exceptions[j] = nullptr;
+            }
+
+            // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+            #pragma omp parallel for schedule(static, 1) ApproxMVBB_OPENMP_NUMTHREADS
+#endif
+            // clang-format on
+            for(int j = 0; j < n; ++j)
+            {
+                try
+                {
+                    boxes[j] = projs[j].computeMVBB(dirs[j], points);
+                    // Expand box such the volume is not zero for points in a plane
+                    boxes[j].expandToMinExtentAbsolute(minBoxExtent);
+                }
+                catch(...)
+                {
+                    exceptions[j] = std::current_exception();
+                }
+            }
+
+            // Replay the serial loop
+            for(int j = 0; j < n; ++j)
+            {
+                if(exceptions[j])
+                {
+                    std::rethrow_exception(exceptions[j]);
+                }
+
+                ++loop;
+                if(boxes[j].volume() < oobb.volume() && boxes[j].volume() > volumeAcceptTol)
                 {
-                    // std::cout << "Change Dir" << std::endl;
-                    // direction are almost the same as in the cache, choose another one
-                    dir = oobb.getDirection(1);
+                    // Continue with the state after this loop
+                    oobb     = boxes[j];
+                    dirCache = dirCaches[j];
                     break;
                 }
             }
-            // Write to cache and shift write idx
-            dirCache[cacheIdx] = dir;
-            cacheIdx           = (cacheIdx + 1) % 3;
+        }
 
-            // std::cout << "Optimizing dir: " << dir << std::endl;
-            OOBB o = proj.computeMVBB(dir, points);
+        return oobb;
+    }
 
-            // Expand box such the volume is not zero for points in a plane
-            o.expandToMinExtentAbsolute(minBoxExtent);
+    namespace details
+    {
+        /** Compute the MVBB of `points` in the grid search direction `dir` and optimize it
+            with `optLoops` loops (see approximateMVBBGridSearch). */
+        template<typename Derived>
+        OOBB computeGridSearchMVBB(const MatrixBase<Derived>& points,
+                                   const Vector3& dir,
+                                   ProjectedPointSet& proj,
+                                   const unsigned int optLoops,
+                                   PREC volumeAcceptFactor,
+                                   PREC minBoxExtent)
+        {
+            ApproxMVBB_MSGLOG_L3("gridSearch: dir: " << dir.transpose() << std::endl);
 
-            if(o.volume() < oobb.volume() && o.volume() > volumeAcceptTol)
+            // Compute MVBB in dirZ
+            auto res = proj.computeMVBB(dir, points);
+
+            // Expand to minimal extent for points in a surface or line
+            res.expandToMinExtentAbsolute(minBoxExtent);
+
+            if(optLoops)
             {
-                oobb = o;
+                res = optimizeMVBB(points, res, proj, optLoops, volumeAcceptFactor, minBoxExtent);
             }
+            ApproxMVBB_MSGLOG_L3("gridSearch: volume: " << res.volume() << std::endl);
+            return res;
         }
 
-        //    // Parallell Loop End
-        //    =====================================================================
-        //    #ifdef ApproxMVBB_OPENMP_SUPPORT
-        //        }
-        //    #endif
+        /** Lower bound of the volume of any box with z-axis `dir` containing `points`
+            (used to prune directions in approximateMVBBGridSearch).
+            The bound is computed from the (at most 26) extreme points of `points` in the 13
+            directions of primitiveGridDirections(1) in the frame of the box `oobb`:
+            a box containing all points contains these, therefore its height in `dir` is at
+            least their height and the area of its rectangle at least the area of their
+            projected 2d convex hull. */
+        class MVBBVolumeBound
+        {
+        public:
+            EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+            ApproxMVBB_DEFINE_MATRIX_TYPES;
+            ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
 
-        return oobb;
-    }
+            static const unsigned int nDirections = 13;
+            static const unsigned int maxPoints   = 2 * nDirections;
+
+            template<typename Derived>
+            void init(const MatrixBase<Derived>& points, const OOBB& oobb)
+            {
+                using IndexType = typename Derived::Index;
+
+                const std::vector<GridDirection>& gridDirs = primitiveGridDirections(1);
+                Matrix33 A_IK                              = oobb.m_q_KI.matrix();
+                std::array<Vector3, nDirections> dirs;
+                for(unsigned int j = 0; j < nDirections; ++j)
+                {
+                    dirs[j] = A_IK * Vector3(gridDirs[j][0], gridDirs[j][1], gridDirs[j][2]);
+                }
+
+                // Extreme points in all directions
+                std::array<IndexType, maxPoints> idx;
+                std::array<PREC, maxPoints> values;
+                idx.fill(0);
+                for(unsigned int j = 0; j < nDirections; ++j)
+                {
+                    values[2 * j]     = std::numeric_limits<PREC>::max();
+                    values[2 * j + 1] = std::numeric_limits<PREC>::lowest();
+                }
+                for(IndexType i = 0; i < points.cols(); ++i)
+                {
+                    for(unsigned int j = 0; j < nDirections; ++j)
+                    {
+                        PREC v = dirs[j].dot(points.col(i));
+                        if(v < values[2 * j])
+                        {
+                            values[2 * j] = v;
+                            idx[2 * j]    = i;
+                        }
+                        if(v > values[2 * j + 1])
+                        {
+                            values[2 * j + 1] = v;
+                            idx[2 * j + 1]    = i;
+                        }
+                    }
+                }
+
+                // Unique extreme points
+                std::sort(idx.begin(), idx.end());
+                auto end = std::unique(idx.begin(), idx.end());
+                m_nPoints = 0;
+                for(auto it = idx.begin(); it != end && points.cols() > 0; ++it)
+                {
+                    m_points.col(m_nPoints++) = points.col(*it);
+                }
+            }
+
+            /** Lower bound of the volume of the box with z-axis `dir`. */
+            PREC operator()(const Vector3& dir) const
+            {
+                if(m_nPoints < 3)
+                {
+                    return 0;
+                }
+
+                Vector3 z = dir, x, y;
+                CoordinateSystem::makeCoordinateSystem(z, x, y);
+
+                std::array<Vector2, maxPoints> p;
+                PREC minZ = std::numeric_limits<PREC>::max();
+                PREC maxZ = std::numeric_limits<PREC>::lowest();
+                for(unsigned int i = 0; i < m_nPoints; ++i)
+                {
+                    p[i]   = Vector2(x.dot(m_points.col(i)), y.dot(m_points.col(i)));
+                    PREC h = z.dot(m_points.col(i));
+                    minZ   = std::min(minZ, h);
+                    maxZ   = std::max(maxZ, h);
+                }
+                return (maxZ - minZ) * hullArea(p);
+            }
+
+        private:
+            /** Area of the convex hull of the first m_nPoints points `p` (monotone chain). */
+            PREC hullArea(std::array<Vector2, maxPoints>& p) const
+            {
+                std::sort(p.begin(), p.begin() + m_nPoints, [](const Vector2& a, const Vector2& b) {
+                    return a(0) < b(0) || (a(0) == b(0) && a(1) < b(1));
+                });
+                auto cross = [](const Vector2& o, const Vector2& a, const Vector2& b) {
+                    return (a(0) - o(0)) * (b(1) - o(1)) - (a(1) - o(1)) * (b(0) - o(0));
+                };
+
+                std::array<Vector2, 2 * maxPoints> hull;
+                unsigned int k = 0;
+                for(unsigned int i = 0; i < m_nPoints; ++i)
+                {
+                    while(k >= 2 && cross(hull[k - 2], hull[k - 1], p[i]) <= 0)
+                    {
+                        --k;
+                    }
+                    hull[k++] = p[i];
+                }
+                for(unsigned int i = m_nPoints - 1, t = k + 1; i > 0; --i)
+                {
+                    while(k >= t && cross(hull[k - 2], hull[k - 1], p[i - 1]) <= 0)
+                    {
+                        --k;
+                    }
+                    hull[k++] = p[i - 1];
+                }
+
+                PREC area = 0;
+                for(unsigned int i = 0; i + 1 < k; ++i)
+                {
+                    area += hull[i](0) * hull[i + 1](1) - hull[i + 1](0) * hull[i](1);
+                }
+                return 0.5 * std::abs(area);
+            }
+
+            MyMatrix::MatrixStatStat<PREC, 3, maxPoints> m_points;  ///< Extreme points.
+            unsigned int m_nPoints = 0;                              ///< Number of extreme points.
+        };
+
+        /** Same as computeGridSearchMVBB above, but all directions are computed through
+            the cache `workspace.m_directionCache` (see DirectionCache). */
+        template<typename Derived>
+        OOBB computeGridSearchMVBB(const MatrixBase<Derived>& points,
+                                   const Vector3& dir,
+                                   MVBBWorkspace& workspace,
+                                   const unsigned int optLoops,
+                                   PREC volumeAcceptFactor,
+                                   PREC minBoxExtent)
+        {
+            auto computeMVBB = [&](const Vector3& d) {
+                return workspace.m_directionCache.computeMVBB(workspace.m_proj, d, points);
+            };
+
+            auto res = computeMVBB(dir);
+            res.expandToMinExtentAbsolute(minBoxExtent);
+            return optimizeMVBBLoops(res, computeMVBB, optLoops, volumeAcceptFactor, minBoxExtent);
+        }
+    }  // namespace details
 
     /*!
         Function to optimize oriented bounding box volume.
@@ -280,6 +1061,10 @@ namespace ApproxMVBB
         @param minBoxExtent is the minmum extent direction a box must have, to make
         the volume not zero and comparable to other volumes
         which is useful for degenerate cases, such as all points in a surface
+        @param pruneDirections skips all directions for which a cheap lower bound of the
+        box volume (see details::MVBBVolumeBound) is not smaller than the current best volume.
+        This is exact without optimization loops (`optLoops = 0`), otherwise a skipped
+        direction might have led to a smaller box after the optimization.
     */
     template<typename Derived>
     OOBB approximateMVBBGridSearch(const MatrixBase<Derived>& points,
@@ -288,7 +1073,8 @@ namespace ApproxMVBB
                                    const unsigned int gridSize = 5,
                                    const unsigned int optLoops = 6,
                                    PREC volumeAcceptFactor     = 1e-6,
-                                   PREC minBoxExtent           = 1e-12)
+                                   PREC minBoxExtent           = 1e-12,
+                                   bool pruneDirections        = false)
     {
         EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
 
@@ -303,65 +1089,57 @@ namespace ApproxMVBB
         Vector3 dir2 = oobb.getDirection(1);
         Vector3 dir3 = oobb.getDirection(2);
 
+        // Primitive directions of the grid (precomputed, no skipped iterations)
+        const std::vector<details::GridDirection>& gridDirs = details::primitiveGridDirections(gridSize);
+        const int nDirs                                     = static_cast<int>(gridDirs.size());
+
+        details::MVBBVolumeBound bound;
+        if(pruneDirections)
+        {
+            bound.init(points, oobb);
+        }
+
         ProjectedPointSet proj;
         Vector3 dir;  // clang-format off
         
 #ifdef ApproxMVBB_OPENMP_SUPPORT
     #if _OPENMP <= 200203
-        #pragma omp parallel shared(points, oobb) private(proj, dir)
+        #pragma omp parallel shared(points, oobb, gridDirs, bound) private(proj, dir)
         {
             OOBB oobbLocal = oobb;
             // Redirect the variable `oobb` to the local one.
             #define oobb oobbLocal 
-            #pragma omp for
+            #pragma omp for schedule(dynamic, 4)
     #else
         #pragma omp declare reduction(volumeIsSmaller                                              \
                                 : OOBB                                                             \
                                 : omp_in.volume() < omp_out.volume() ? omp_out = omp_in : omp_out) \
         initializer(omp_priv(omp_orig))
 
-        #pragma omp parallel for schedule(dynamic, 4) collapse(3) shared(points) private(proj, dir) \
-                reduction(volumeIsSmaller                                                           \
+        #pragma omp parallel for schedule(dynamic, 4) shared(points, gridDirs, bound) private(proj, dir) \
+                reduction(volumeIsSmaller                                                                \
                         : oobb) ApproxMVBB_OPENMP_NUMTHREADS
     #endif
 #endif
         // clang-format on
-        for(int x = -int(gridSize); x <= (int)gridSize; ++x)
+        for(int i = 0; i < nDirs; ++i)
         {
-            for(int y = -int(gridSize); y <= (int)gridSize; ++y)
-            {
-                for(int z = 0; z <= (int)gridSize; ++z)
-                {
-                    if(MathFunctions::gcd3(x, y, z) > 1 || ((x == 0) && (y == 0) && (z == 0)))
-                    {
-                        continue;
-                    }
-
-                    // Make direction
-                    Vector3 dir = x * dir1 + y * dir2 + z * dir3;
-                    ApproxMVBB_MSGLOG_L3("gridSearch: dir: " << dir.transpose() << std::endl);
-
-                    // Compute MVBB in dirZ
-                    auto res = proj.computeMVBB(dir, points);
+            // Make direction
+            const details::GridDirection& g = gridDirs[i];
+            dir                             = g[0] * dir1 + g[1] * dir2 + g[2] * dir3;
 
-                    // Expand to minimal extent for points in a surface or line
-                    res.expandToMinExtentAbsolute(minBoxExtent);
+            if(pruneDirections && bound(dir) >= oobb.volume())
+            {
+                continue;
+            }
 
-                    if(optLoops)
-                    {
-                        res = optimizeMVBB(points, res, optLoops, volumeAcceptFactor, minBoxExtent);
-                    }
-                    ApproxMVBB_MSGLOG_L3("gridSearch: volume: "
-                                         << res.volume()
-                                         << std::endl);
+            auto res = details::computeGridSearchMVBB(points, dir, proj, optLoops, volumeAcceptFactor, minBoxExtent);
 
-                    if(res.volume() < oobb.volume() /*&& res.volume()>volumeAcceptTol */)
-                    {
-                        ApproxMVBB_MSGLOG_L2("gridSearch: new volume: " << res.volume() << std::endl
-                                                                        << "for dir: " << dir.transpose() << std::endl);
-                        oobb = res;
-                    }
-                }
+            if(res.volume() < oobb.volume() /*&& res.volume()>volumeAcceptTol */)
+            {
+                ApproxMVBB_MSGLOG_L2("gridSearch: new volume: " << res.volume() << std::endl
+                                                                << "for dir: " << dir.transpose() << std::endl);
+                oobb = res;
             }
         }
         
@@ -378,6 +1156,73 @@ namespace ApproxMVBB
         return oobb;
     }
 
+    /*!
+        Same as approximateMVBBGridSearch above, but runs serially and reuses the buffers
+        in `workspace` for all directions (see approximateMVBBBatch).
+        With `workspace.m_directionCache.setEnabled(true)` equivalent directions of the grid
+        and of the optimization loops are computed only once,
+        `workspace.m_directionCache.hits()/misses()` report the savings of the last call
+        (see DirectionCache).
+        `workspace.m_gridDirections` and `workspace.m_prunedDirections` report the number
+        of directions and the number of directions skipped by `pruneDirections`.
+    */
+    template<typename Derived>
+    OOBB approximateMVBBGridSearch(const MatrixBase<Derived>& points,
+                                   OOBB oobb,
+                                   MVBBWorkspace& workspace,
+                                   PREC /*epsilon*/,
+                                   const unsigned int gridSize = 5,
+                                   const unsigned int optLoops = 6,
+                                   PREC volumeAcceptFactor     = 1e-6,
+                                   PREC minBoxExtent           = 1e-12,
+                                   bool pruneDirections        = false)
+    {
+        EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
+
+        // Extent input oobb
+        oobb.expandToMinExtentAbsolute(minBoxExtent);
+        workspace.m_directionCache.clear();
+
+        // Get the direction of the input OOBB in coordinate system `I` :
+        Vector3 dir1 = oobb.getDirection(0);
+        Vector3 dir2 = oobb.getDirection(1);
+        Vector3 dir3 = oobb.getDirection(2);
+
+        details::MVBBVolumeBound bound;
+        if(pruneDirections)
+        {
+            bound.init(points, oobb);
+        }
+
+        const std::vector<details::GridDirection>& gridDirs = details::primitiveGridDirections(gridSize);
+        workspace.m_gridDirections                          = gridDirs.size();
+        workspace.m_prunedDirections                        = 0;
+
+        for(const details::GridDirection& g : gridDirs)
+        {
+            // Make direction
+            Vector3 dir = g[0] * dir1 + g[1] * dir2 + g[2] * dir3;
+
+            if(pruneDirections && bound(dir) >= oobb.volume())
+            {
+                ++workspace.m_prunedDirections;
+                continue;
+            }
+
+            auto res =
+                details::computeGridSearchMVBB(points, dir, workspace, optLoops, volumeAcceptFactor, minBoxExtent);
+
+            if(res.volume() < oobb.volume())
+            {
+                ApproxMVBB_MSGLOG_L2("gridSearch: new volume: " << res.volume() << std::endl
+                                                                << "for dir: " << dir.transpose() << std::endl);
+                oobb = res;
+            }
+        }
+
+        return oobb;
+    }
+
     /*!
         Function to optimize oriented bounding box volume.
         This constructs an approximation of a tightly fitted bounding box by computing
@@ -388,6 +1233,7 @@ namespace ApproxMVBB
     */
     template<typename Derived>
     OOBB approximateMVBBDiam(const MatrixBase<Derived>& points,
+                             MVBBWorkspace& workspace,
                              const PREC epsilon,
                              const unsigned int optLoops = 10,
                              std::size_t seed            = ApproxMVBB::RandomGenerators::defaultSeed)
@@ -395,7 +1241,8 @@ namespace ApproxMVBB
         EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
 
         using namespace PointFunctions;
-        auto pp = estimateDiameter<3>(points, epsilon, seed);
+        auto pp =
+            estimateDiameter<3>(points, epsilon, workspace.m_diameterEstimator, workspace.m_diameterPoints, seed);
 
         ApproxMVBB::MyMatrix::Vector3<ApproxMVBB::TypeDefsPoints::PREC> dirZ = pp.first - pp.second;
 
@@ -414,18 +1261,54 @@ namespace ApproxMVBB
         ApproxMVBB_MSGLOG_L1("estimated 3d diameter: " << dirZ.transpose() << " eps: " << epsilon << std::endl);
 
         // Compute MVBB in dirZ
-        ProjectedPointSet proj;
+        ProjectedPointSet& proj = workspace.m_proj;
         // OOBB oobb = proj.computeMVBB();
         // or faster estimate diameter in projected plane and build coordinate system
         OOBB oobb = proj.computeMVBBApprox(dirZ, points, epsilon);
 
         if(optLoops)
         {
-            oobb = optimizeMVBB(points, oobb, optLoops);
+            oobb = optimizeMVBB(points, oobb, proj, optLoops);
         }
         return oobb;
     }
 
+    /*!
+        Same as approximateMVBBDiam above with its own workspace.
+        @param parallelOptLoops runs the `optLoops` loops with optimizeMVBBParallel (same result,
+        but one projection of all points per thread) instead of optimizeMVBB
+    */
+    template<typename Derived>
+    OOBB approximateMVBBDiam(const MatrixBase<Derived>& points,
+                             const PREC epsilon,
+                             const unsigned int optLoops = 10,
+                             std::size_t seed            = ApproxMVBB::RandomGenerators::defaultSeed,
+                             bool parallelOptLoops       = false)
+    {
+        MVBBWorkspace workspace;
+        if(!parallelOptLoops)
+        {
+            return approximateMVBBDiam(points, workspace, epsilon, optLoops, seed);
+        }
+
+        OOBB oobb = approximateMVBBDiam(points, workspace, epsilon, 0, seed);
+        if(optLoops)
+        {
+            oobb = optimizeMVBBParallel(points, oobb, optLoops);
+        }
+        return oobb;
+    }
+
+    /*!
+        Approximate MVBB: approximateMVBBDiam, samplePointsGrid and approximateMVBBGridSearch.
+        @param convexHull replaces the points by the vertices of their 3d convex hull
+        (ConvexHull3D) before all searches. Only hull vertices matter for any box, thus the
+        boxes of all directions are the same (up to the tolerance of the hull), while the
+        searches only project the (usually much fewer) hull vertices.
+        @param sampleGridMode is the grid of samplePointsGrid, the anisotropic grids give a better
+        sample for elongated point clouds at the same `pointSamples`.
+        @param samplePadding is the padding of samplePointsGrid for grids with empty cells.
+    */
     template<typename Derived>
     OOBB approximateMVBB(const MatrixBase<Derived>& points,
                          const PREC epsilon,
@@ -433,10 +1316,31 @@ namespace ApproxMVBB
                          const unsigned int gridSize               = 5,
                          const unsigned int mvbbDiamOptLoops       = 0,
                          const unsigned int mvbbGridSearchOptLoops = 6,
-                         std::size_t seed                          = ApproxMVBB::RandomGenerators::defaultSeed)
+                         std::size_t seed                          = ApproxMVBB::RandomGenerators::defaultSeed,
+                         bool convexHull                           = false,
+                         SampleGridMode sampleGridMode             = SampleGridMode::Square,
+                         SamplePadding samplePadding               = SamplePadding::Random)
     {
         EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
 
+        if(convexHull)
+        {
+            Matrix3Dyn vertices;
+            ConvexHull3D hull(points);
+            hull.compute();
+            hull.getVertices(vertices);
+            return approximateMVBB(vertices,
+                                   epsilon,
+                                   pointSamples,
+                                   gridSize,
+                                   mvbbDiamOptLoops,
+                                   mvbbGridSearchOptLoops,
+                                   seed,
+                                   false,
+                                   sampleGridMode,
+                                   samplePadding);
+        }
+
         // Get get MVBB from estimated diameter direction
         // take care forwarding means not using gen anymore !
         auto oobb = approximateMVBBDiam(points, epsilon, mvbbDiamOptLoops, seed);
@@ -446,7 +1350,7 @@ namespace ApproxMVBB
         {
             // sample points
             Matrix3Dyn sampled;
-            samplePointsGrid(sampled, points, pointSamples, oobb, seed);
+            samplePointsGrid(sampled, points, pointSamples, oobb, seed, sampleGridMode, samplePadding);
 
             // Exhaustive grid search with sampled points
             oobb = approximateMVBBGridSearch(sampled, oobb, epsilon, gridSize, mvbbGridSearchOptLoops);
@@ -459,6 +1363,686 @@ namespace ApproxMVBB
 
         return oobb;
     }
+
+    /*!
+        Same as approximateMVBB above, but all scratch buffers are taken from `workspace`,
+        such that repeated calls with the same workspace reuse them.
+        The grid search runs serially (see approximateMVBBBatch for the parallel version
+        over many point sets). With `convexHull` the hull vertices are stored in
+        `workspace.m_hullVertices` (the hull itself allocates).
+    */
+    template<typename Derived>
+    OOBB approximateMVBB(const MatrixBase<Derived>& points,
+                         MVBBWorkspace& workspace,
+                         const PREC epsilon,
+                         const unsigned int pointSamples           = 400,
+                         const unsigned int gridSize               = 5,
+                         const unsigned int mvbbDiamOptLoops       = 0,
+                         const unsigned int mvbbGridSearchOptLoops = 6,
+                         std::size_t seed                          = ApproxMVBB::RandomGenerators::defaultSeed,
+                         bool convexHull                           = false,
+                         SampleGridMode sampleGridMode             = SampleGridMode::Square,
+                         SamplePadding samplePadding               = SamplePadding::Random)
+    {
+        EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
+
+        if(convexHull)
+        {
+            ConvexHull3D hull(points);
+            hull.compute();
+            hull.getVertices(workspace.m_hullVertices);
+            return approximateMVBB(workspace.m_hullVertices,
+                                   workspace,
+                                   epsilon,
+                                   pointSamples,
+                                   gridSize,
+                                   mvbbDiamOptLoops,
+                                   mvbbGridSearchOptLoops,
+                                   seed,
+                                   false,
+                                   sampleGridMode,
+                                   samplePadding);
+        }
+
+        auto oobb = approximateMVBBDiam(points, workspace, epsilon, mvbbDiamOptLoops, seed);
+
+        // Check if we sample the point cloud
+        if(pointSamples < points.cols())
+        {
+            // sample points
+            samplePointsGrid(workspace.m_sampled,
+                             points,
+                             pointSamples,
+                             oobb,
+                             workspace.m_sampleGrid,
+                             seed,
+                             sampleGridMode,
+                             samplePadding);
+
+            // Exhaustive grid search with sampled points
+            oobb = approximateMVBBGridSearch(
+                workspace.m_sampled, oobb, workspace, epsilon, gridSize, mvbbGridSearchOptLoops);
+        }
+        else
+        {
+            // Exhaustive grid search with all points
+            oobb = approximateMVBBGridSearch(points, oobb, workspace, epsilon, gridSize, mvbbGridSearchOptLoops);
+        }
+
+        return oobb;
+    }
+
+    /*!
+        Warm-started approximateMVBB for moving or deforming bodies, where `prior`
+        is the box of the previous frame (e.g. the result of the last call).
+        The points are fitted with the minimal box in the direction `z` of `prior`,
+        sampled with samplePointsGrid and only a local grid search with `localGridSize`
+        (instead of `gridSize`) around this box is performed.
+        If the resulting volume exceeds `volumeTolerance * prior.volume()`, the full
+        approximateMVBB (diameter estimation and grid search with `gridSize`) is run
+        as fallback and the smaller box of both is returned.
+
+        @param localGridSize is half the grid size of the local grid search
+               (see approximateMVBBGridSearch), `49` instead of `577` directions
+               (details::primitiveGridDirections) for the default values
+        @param volumeTolerance is the factor by which the volume may grow relative to
+               `prior` before the full search is run
+    */
+    template<typename Derived>
+    OOBB approximateMVBBWarmStart(const MatrixBase<Derived>& points,
+                                  const OOBB& prior,
+                                  MVBBWorkspace& workspace,
+                                  const PREC epsilon,
+                                  const unsigned int pointSamples           = 400,
+                                  const unsigned int localGridSize          = 2,
+                                  const unsigned int gridSize               = 5,
+                                  const unsigned int mvbbGridSearchOptLoops = 6,
+                                  const PREC volumeTolerance                = 1.1,
+                                  std::size_t seed                          = ApproxMVBB::RandomGenerators::defaultSeed)
+    {
+        EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
+
+        // Fit the box in the direction of the prior
+        OOBB oobb = workspace.m_proj.computeMVBB(prior.getDirection(2), points);
+        oobb.expandToMinExtentAbsolute(1e-12);
+
+        // Local grid search around the fitted box
+        if(pointSamples < points.cols())
+        {
+            samplePointsGrid(workspace.m_sampled, points, pointSamples, oobb, workspace.m_sampleGrid, seed);
+            oobb = approximateMVBBGridSearch(
+                workspace.m_sampled, oobb, workspace, epsilon, localGridSize, mvbbGridSearchOptLoops);
+        }
+        else
+        {
+            oobb = approximateMVBBGridSearch(points, oobb, workspace, epsilon, localGridSize, mvbbGridSearchOptLoops);
+        }
+
+        if(oobb.volume() <= volumeTolerance * prior.volume())
+        {
+            return oobb;
+        }
+
+        // Volume regressed: full search
+        ApproxMVBB_MSGLOG_L1("warm start: volume regressed: " << oobb.volume() << " > " << volumeTolerance << " * "
+                                                               << prior.volume() << std::endl);
+        OOBB full = approximateMVBB(
+            points, workspace, epsilon, pointSamples, gridSize, 0, mvbbGridSearchOptLoops, seed);
+        return full.volume() < oobb.volume() ? full : oobb;
+    }
+
+    /*!
+        Same as approximateMVBBWarmStart above with a temporary workspace.
+    */
+    template<typename Derived>
+    OOBB approximateMVBBWarmStart(const MatrixBase<Derived>& points,
+                                  const OOBB& prior,
+                                  const PREC epsilon,
+                                  const unsigned int pointSamples           = 400,
+                                  const unsigned int localGridSize          = 2,
+                                  const unsigned int gridSize               = 5,
+                                  const unsigned int mvbbGridSearchOptLoops = 6,
+                                  const PREC volumeTolerance                = 1.1,
+                                  std::size_t seed                          = ApproxMVBB::RandomGenerators::defaultSeed)
+    {
+        MVBBWorkspace workspace;
+        return approximateMVBBWarmStart(points,
+                                        prior,
+                                        workspace,
+                                        epsilon,
+                                        pointSamples,
+                                        localGridSize,
+                                        gridSize,
+                                        mvbbGridSearchOptLoops,
+                                        volumeTolerance,
+                                        seed);
+    }
+
+    namespace details
+    {
+        /** Extreme points of a point stream in the 13 directions `(x,y,z)` with
+            `x,y,z` in `{-1,0,1}` (up to sign). The diameter of these (at most 26) points
+            approximates the diameter of all points. */
+        class StreamingExtremePoints
+        {
+        public:
+            ApproxMVBB_DEFINE_MATRIX_TYPES;
+            ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
+
+            static const unsigned int nDirections = 13;
+
+            StreamingExtremePoints()
+            {
+                // clang-format off
+                m_dirs << 1, 0, 0, 1,  1, 1,  1, 0,  0, 1,  1,  1,  1,
+                          0, 1, 0, 1, -1, 0,  0, 1,  1, 1,  1, -1, -1,
+                          0, 0, 1, 0,  0, 1, -1, 1, -1, 1, -1,  1, -1;
+                // clang-format on
+                m_minValue.fill(std::numeric_limits<PREC>::max());
+                m_maxValue.fill(std::numeric_limits<PREC>::lowest());
+            }
+
+            template<typename Derived>
+            void add(const MatrixBase<Derived>& points)
+            {
+                auto size = points.cols();
+                for(decltype(size) i = 0; i < size; ++i)
+                {
+                    Vector3 p = points.col(i);
+                    MyMatrix::VectorStat<PREC, nDirections> values = m_dirs.transpose() * p;
+                    for(unsigned int k = 0; k < nDirections; ++k)
+                    {
+                        if(values(k) < m_minValue(k))
+                        {
+                            m_minValue(k)      = values(k);
+                            m_minPoints.col(k) = p;
+                        }
+                        if(values(k) > m_maxValue(k))
+                        {
+                            m_maxValue(k)      = values(k);
+                            m_maxPoints.col(k) = p;
+                        }
+                    }
+                }
+                m_nPoints += static_cast<std::size_t>(size);
+            }
+
+            /** Number of added points */
+            std::size_t size() const
+            {
+                return m_nPoints;
+            }
+
+            /** The extreme points (minimum and maximum in each direction) */
+            Matrix3Dyn points() const
+            {
+                Matrix3Dyn p(3, 2 * nDirections);
+                p << m_minPoints, m_maxPoints;
+                return p;
+            }
+
+        private:
+            MyMatrix::MatrixStatStat<PREC, 3, nDirections> m_dirs;                    ///< Directions.
+            MyMatrix::VectorStat<PREC, nDirections> m_minValue, m_maxValue;           ///< Extreme values.
+            MyMatrix::MatrixStatStat<PREC, 3, nDirections> m_minPoints, m_maxPoints;  ///< Extreme points.
+            std::size_t m_nPoints = 0;                                                ///< Number of added points.
+        };
+
+        /** Grid sampling of samplePointsGrid for a point stream: stores the bottom/top point of each grid
+            cell and a reservoir sample (Li's algorithm L) of `nPoints` random points, which pads
+            the sample if the grid has too little points. At most `2 nPoints` points are stored. */
+        class StreamingSampleGrid
+        {
+        public:
+            EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+            ApproxMVBB_DEFINE_MATRIX_TYPES;
+            ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
+
+            StreamingSampleGrid() = default;
+
+            /** The grid is constructed as in samplePointsGrid (this sets the z-axis of `oobb` to the longest extent) */
+            StreamingSampleGrid(const unsigned int nPoints, OOBB& oobb, std::size_t seed)
+            {
+                reset(nPoints, oobb, seed);
+            }
+
+            /** Remove all points and construct the grid (see constructor) */
+            void reset(const unsigned int nPoints, OOBB& oobb, std::size_t seed)
+            {
+                m_nPoints  = nPoints;
+                m_gridSize = std::max(static_cast<unsigned int>(std::sqrt(static_cast<double>(nPoints) / 2.0)), 1U);
+                oobb.setZAxisLongest();
+                m_cells.assign(m_gridSize * m_gridSize, Cell{});
+                m_dxdyInv  = Array2(m_gridSize, m_gridSize) / oobb.extent().head<2>();
+                m_A_KI     = oobb.m_q_KI.matrix().transpose();
+                m_minPoint = oobb.m_minPoint;
+                m_reservoir.resize(3, nPoints);
+                m_seen = 0;
+                m_next = 0;
+                m_w    = 0;
+                m_gen.seed(seed);
+            }
+
+            template<typename Derived>
+            void add(const MatrixBase<Derived>& points)
+            {
+                using LongInt = long long int;
+                MyMatrix::Array2<LongInt> idx;
+                Vector3 K_p;
+
+                auto size = points.cols();
+                for(decltype(size) i = 0; i < size; ++i)
+                {
+                    // Register point in grid (see samplePointsGrid)
+                    K_p    = m_A_KI * points.col(i);
+                    idx    = ((K_p - m_minPoint).head<2>().array() * m_dxdyInv).template cast<LongInt>();
+                    idx(0) = std::max(std::min(LongInt(m_gridSize - 1), idx(0)), 0LL);
+                    idx(1) = std::max(std::min(LongInt(m_gridSize - 1), idx(1)), 0LL);
+
+                    auto& c = m_cells[idx(0) + idx(1) * m_gridSize];
+                    if(c.m_empty)
+                    {
+                        c.m_empty  = false;
+                        c.m_top    = c.m_bottom = points.col(i);
+                        c.m_topZ   = c.m_bottomZ = K_p(2);
+                        c.m_single = true;
+                    }
+                    else if(c.m_topZ < K_p(2))
+                    {
+                        c.m_top    = points.col(i);
+                        c.m_topZ   = K_p(2);
+                        c.m_single = false;
+                    }
+                    else if(c.m_bottomZ > K_p(2))
+                    {
+                        c.m_bottom  = points.col(i);
+                        c.m_bottomZ = K_p(2);
+                        c.m_single  = false;
+                    }
+
+                    addToReservoir(points.col(i));
+                }
+            }
+
+            /** Get the sampled points (the top/bottom points of all grid cells, padded with random points),
+                or all points if not more than `nPoints` points have been added */
+            void getSample(Matrix3Dyn& newPoints)
+            {
+                if(m_seen <= m_nPoints)
+                {
+                    newPoints = m_reservoir.leftCols(static_cast<Matrix3Dyn::Index>(m_seen));
+                    return;
+                }
+
+                newPoints.resize(3, m_nPoints);
+                unsigned int k = 0;
+                for(auto& c : m_cells)
+                {
+                    if(!c.m_empty)
+                    {
+                        newPoints.col(k++) = c.m_top;
+                        if(!c.m_single)
+                        {
+                            newPoints.col(k++) = c.m_bottom;
+                        }
+                    }
+                }
+                for(unsigned int r = 0; k < m_nPoints; ++r)
+                {
+                    newPoints.col(k++) = m_reservoir.col(r);
+                }
+            }
+
+        private:
+            struct Cell
+            {
+                Vector3 m_top, m_bottom;
+                PREC m_topZ, m_bottomZ;
+                bool m_empty  = true;
+                bool m_single = true;  ///< Top and bottom point are the same point.
+            };
+
+            void addToReservoir(const Vector3& p)
+            {
+                if(m_seen < m_nPoints)
+                {
+                    m_reservoir.col(m_seen) = p;
+                    if(++m_seen == m_nPoints)
+                    {
+                        m_w = std::exp(std::log(random()) / m_nPoints);
+                        skip();
+                    }
+                    return;
+                }
+                if(m_seen++ == m_next)
+                {
+                    RandomGenerators::DefaultUniformUIntDistribution<unsigned int> dis(0, m_nPoints - 1);
+                    m_reservoir.col(dis(m_gen)) = p;
+                    m_w *= std::exp(std::log(random()) / m_nPoints);
+                    skip();
+                }
+            }
+
+            /** Index of the next point which replaces a point in the reservoir */
+            void skip()
+            {
+                double s = std::floor(std::log(random()) / std::log1p(-m_w));
+                m_next   = m_seen + static_cast<unsigned long long int>(std::min(s, 1e18));
+            }
+
+            /** Random number in (0,1] */
+            double random()
+            {
+                return 1.0 - m_uni(m_gen);
+            }
+
+            unsigned int m_nPoints  = 0;
+            unsigned int m_gridSize = 1;
+            std::vector<Cell> m_cells;
+            Array2 m_dxdyInv;
+            Matrix33 m_A_KI;
+            Vector3 m_minPoint;
+
+            Matrix3Dyn m_reservoir;
+            unsigned long long int m_seen = 0;  ///< Number of registered points.
+            unsigned long long int m_next = 0;  ///< Index of the next point which goes into the reservoir.
+            double m_w                    = 0;
+            RandomGenerators::DefaultRandomGen m_gen;
+            RandomGenerators::DefaultUniformRealDistribution<double> m_uni{0.0, 1.0};
+        };
+    }  // namespace details
+
+    /*!
+        Computes approximateMVBB for a point cloud which is only available block by block
+        (e.g. larger than memory). `producer(consume)` needs to call `consume(block)` for all
+        blocks of the point cloud, where `block` is a `3 x n` matrix expression
+        (e.g. a MatrixMap into a read buffer). The producer has to deliver the same points
+        in the same order on each call, it is called once for each pass over the points:
+
+        1. the extreme points in 13 directions, whose diameter is the estimated diameter direction,
+        2. the MVBB in the diameter direction (ProjectedPointSet::addMVBBStreaming) and one
+           more pass for each of the `mvbbDiamOptLoops` optimization loops (see optimizeMVBB),
+        3. the grid sampling of `pointSamples` representative points (see samplePointsGrid)
+           padded with a reservoir sample of random points.
+
+        Only the extreme points, the candidate points of the 2d convex hull (about twice the hull
+        plus one block, see ProjectedPointSet::computeMVBBStreaming) and the sample are kept in
+        memory. The exhaustive grid search on the sample is the same as in approximateMVBB.
+    */
+    template<typename Producer>
+    OOBB approximateMVBBStreaming(Producer&& producer,
+                                  MVBBWorkspace& workspace,
+                                  const PREC epsilon,
+                                  const unsigned int pointSamples           = 400,
+                                  const unsigned int gridSize               = 5,
+                                  const unsigned int mvbbDiamOptLoops       = 0,
+                                  const unsigned int mvbbGridSearchOptLoops = 6,
+                                  std::size_t seed = ApproxMVBB::RandomGenerators::defaultSeed)
+    {
+        // Pass 1: diameter estimate of the extreme points
+        details::StreamingExtremePoints extremePoints;
+        producer([&](const auto& block) { extremePoints.add(block); });
+
+        if(extremePoints.size() == 0)
+        {
+            ApproxMVBB_ERRORMSG("Point set empty!");
+        }
+
+        Matrix3Dyn extremes = extremePoints.points();
+        auto pp             = PointFunctions::estimateDiameter<3>(
+            extremes, epsilon, workspace.m_diameterEstimator, workspace.m_diameterPoints, seed);
+
+        Vector3 dirZ = pp.first - pp.second;
+        if((dirZ.array() <= 0.0).all())
+        {
+            dirZ *= -1;
+        }
+        // If direction zero, use (1,0)
+        if((dirZ.array() == 0.0).all())
+        {
+            dirZ.setZero();
+            dirZ(0) = 1;
+        }
+        ApproxMVBB_MSGLOG_L1("estimated 3d diameter (streaming): " << dirZ.transpose() << std::endl);
+
+        // Pass 2: MVBB in the diameter direction (and the optimization loops)
+        ProjectedPointSet& proj = workspace.m_proj;
+        auto computeMVBB        = [&](const Vector3& dir) {
+            proj.beginMVBBStreaming(dir);
+            producer([&](const auto& block) { proj.addMVBBStreaming(block); });
+            return proj.endMVBBStreaming();
+        };
+
+        OOBB oobb = computeMVBB(dirZ);
+        if(mvbbDiamOptLoops && oobb.volume() != 0.0)
+        {
+            // see optimizeMVBB
+            PREC volumeAcceptTol = oobb.volume() * 1e-6;
+            details::OptimizeDirectionCache dirCache;
+            for(unsigned int loop = 0; loop < mvbbDiamOptLoops; ++loop)
+            {
+                OOBB o = computeMVBB(dirCache.next(oobb));
+                o.expandToMinExtentAbsolute(1e-12);
+                if(o.volume() < oobb.volume() && o.volume() > volumeAcceptTol)
+                {
+                    oobb = o;
+                }
+            }
+        }
+
+        // Pass 3: sample the points (or collect all points if there are not more)
+        if(pointSamples < extremePoints.size())
+        {
+            if(pointSamples < 2)
+            {
+                ApproxMVBB_ERRORMSG("Wrong arguments!"
+                                    << "sample nPoints: (>2) " << pointSamples << std::endl)
+            }
+            details::StreamingSampleGrid grid(pointSamples, oobb, seed);
+            producer([&](const auto& block) { grid.add(block); });
+            grid.getSample(workspace.m_sampled);
+        }
+        else
+        {
+            Matrix3Dyn& sampled = workspace.m_sampled;
+            sampled.resize(3, static_cast<Matrix3Dyn::Index>(extremePoints.size()));
+            Matrix3Dyn::Index k = 0;
+            producer([&](const auto& block) {
+                sampled.middleCols(k, block.cols()) = block;
+                k += block.cols();
+            });
+        }
+
+        // Exhaustive grid search with sampled points
+        return approximateMVBBGridSearch(
+            workspace.m_sampled, oobb, workspace, epsilon, gridSize, mvbbGridSearchOptLoops);
+    }
+
+    template<typename Producer>
+    OOBB approximateMVBBStreaming(Producer&& producer,
+                                  const PREC epsilon,
+                                  const unsigned int pointSamples           = 400,
+                                  const unsigned int gridSize               = 5,
+                                  const unsigned int mvbbDiamOptLoops       = 0,
+                                  const unsigned int mvbbGridSearchOptLoops = 6,
+                                  std::size_t seed = ApproxMVBB::RandomGenerators::defaultSeed)
+    {
+        MVBBWorkspace workspace;
+        return approximateMVBBStreaming(std::forward<Producer>(producer),
+                                        workspace,
+                                        epsilon,
+                                        pointSamples,
+                                        gridSize,
+                                        mvbbDiamOptLoops,
+                                        mvbbGridSearchOptLoops,
+                                        seed);
+    }
+
+    /*!
+        Computes approximateMVBB for many point sets in one call.
+        The point set `i` consists of the columns `[offsets[i], offsets[i+1])` of `points`,
+        so `offsets` contains one entry more than there are point sets.
+        The point sets are distributed over all threads (OpenMP) and each thread reuses
+        one MVBBWorkspace for all its point sets. All other parameters are applied to each
+        point set as in approximateMVBB.
+        An exception of any point set is rethrown after all point sets are done
+        (the one of the first failing point set).
+        @return The OOBB for each point set.
+    */
+    template<typename Derived, typename IndexContainer>
+    StdVecAligned<OOBB> approximateMVBBBatch(const MatrixBase<Derived>& points,
+                                             const IndexContainer& offsets,
+                                             const PREC epsilon,
+                                             const unsigned int pointSamples           = 400,
+                                             const unsigned int gridSize               = 5,
+                                             const unsigned int mvbbDiamOptLoops       = 0,
+                                             const unsigned int mvbbGridSearchOptLoops = 6,
+                                             std::size_t seed = ApproxMVBB::RandomGenerators::defaultSeed,
+                                             bool convexHull                           = false,
+                                             SampleGridMode sampleGridMode             = SampleGridMode::Square,
+                                             SamplePadding samplePadding               = SamplePadding::Random)
+    {
+        EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
+        using IndexType = typename Derived::Index;
+
+        // Check all point sets before going parallel
+        long long int nSets = offsets.size() > 0 ? static_cast<long long int>(offsets.size()) - 1 : 0;
+        for(long long int i = 0; i < nSets; ++i)
+        {
+            auto first = static_cast<IndexType>(offsets[i]);
+            auto last  = static_cast<IndexType>(offsets[i + 1]);
+            if(first < 0 || first >= last || last > points.cols())
+            {
+                ApproxMVBB_ERRORMSG("Wrong offsets for point set " << i << ": [" << first << "," << last
+                                                                   << ") of points: " << points.cols());
+            }
+        }
+
+        StdVecAligned<OOBB> oobbs(static_cast<std::size_t>(nSets));
+        std::vector<std::exception_ptr> exceptions(static_cast<std::size_t>(nSets));
+
+        // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+        #pragma omp parallel ApproxMVBB_OPENMP_NUMTHREADS
+#endif
+        // clang-format on
+        {
+            MVBBWorkspace workspace;
+
+            // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+            #pragma omp for schedule(dynamic, 8)
+#endif
+            // clang-format on
+            for(long long int i = 0; i < nSets; ++i)
+            {
+                try
+                {
+                    auto first = static_cast<IndexType>(offsets[i]);
+                    auto size  = static_cast<IndexType>(offsets[i + 1]) - first;
+                    oobbs[i]   = approximateMVBB(points.middleCols(first, size),
+                                               workspace,
+                                               epsilon,
+                                               pointSamples,
+                                               gridSize,
+                                               mvbbDiamOptLoops,
+                                               mvbbGridSearchOptLoops,
+                                               seed,
+                                               convexHull,
+                                               sampleGridMode,
+                                               samplePadding);
+                }
+                catch(...)
+                {
+                    exceptions[i] = std::current_exception();
+                }
+            }
+        }
+
+        for(auto& e : exceptions)
+        {
+            if(e)
+            {
+                std::rethrow_exception(e);
+            }
+        }
+        return oobbs;
+    }
+
+    /*!
+        Computes approximateMVBB for each point set in `pointSets`
+        (a random access container of `3xN` point matrices, e.g. `std::vector<Matrix3Dyn>`
+        or a list of `MatrixMap` views), see approximateMVBBBatch above.
+    */
+    template<typename PointSetContainer>
+    StdVecAligned<OOBB> approximateMVBBBatch(const PointSetContainer& pointSets,
+                                             const PREC epsilon,
+                                             const unsigned int pointSamples           = 400,
+                                             const unsigned int gridSize               = 5,
+                                             const unsigned int mvbbDiamOptLoops       = 0,
+                                             const unsigned int mvbbGridSearchOptLoops = 6,
+                                             std::size_t seed = ApproxMVBB::RandomGenerators::defaultSeed,
+                                             bool convexHull                           = false,
+                                             SampleGridMode sampleGridMode             = SampleGridMode::Square,
+                                             SamplePadding samplePadding               = SamplePadding::Random)
+    {
+        long long int nSets = static_cast<long long int>(pointSets.size());
+        for(long long int i = 0; i < nSets; ++i)
+        {
+            if(pointSets[i].cols() == 0)
+            {
+                ApproxMVBB_ERRORMSG("Point set " << i << " is empty!");
+            }
+        }
+
+        StdVecAligned<OOBB> oobbs(static_cast<std::size_t>(nSets));
+        std::vector<std::exception_ptr> exceptions(static_cast<std::size_t>(nSets));
+
+        // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+        #pragma omp parallel ApproxMVBB_OPENMP_NUMTHREADS
+#endif
+        // clang-format on
+        {
+            MVBBWorkspace workspace;
+
+            // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+            #pragma omp for schedule(dynamic, 8)
+#endif
+            // clang-format on
+            for(long long int i = 0; i < nSets; ++i)
+            {
+                try
+                {
+                    oobbs[i] = approximateMVBB(pointSets[i],
+                                               workspace,
+                                               epsilon,
+                                               pointSamples,
+                                               gridSize,
+                                               mvbbDiamOptLoops,
+                                               mvbbGridSearchOptLoops,
+                                               seed,
+                                               convexHull,
+                                               sampleGridMode,
+                                               samplePadding);
+                }
+                catch(...)
+                {
+                    exceptions[i] = std::current_exception();
+                }
+            }
+        }
+
+        for(auto& e : exceptions)
+        {
+            if(e)
+            {
+                std::rethrow_exception(e);
+            }
+        }
+        return oobbs;
+    }
 }  // namespace ApproxMVBB
 
 #endif  // ApproxMVBB_hpp
@@ -50,6 +50,11 @@ namespace ApproxMVBB{
         
     #endif
     
+    // Floating point type of the library (double or float)
+    // With float, the points are stored and copied in float, only the robust predicates
+    // and the distances in the diameter estimation are evaluated in double
+    #define ApproxMVBB_PREC @ApproxMVBB_PREC@
+
     // Force log level
     #define ApproxMVBB_FORCE_MSGLOG_LEVEL @ApproxMVBB_FORCE_MSGLOG_LEVEL@
     
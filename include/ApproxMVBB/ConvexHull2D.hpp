@@ -26,6 +26,8 @@ namespace ApproxMVBB
  * points are angle sorted afterwards
  * Function getIndices() returns the ascending indices of the sorted point list
  * which span the convex hull.
+ * All algorithms return the hull in counter-clockwise order (without collinear points)
+ * starting at the lowest (and leftmost) point and use the robust orient2d predicate.
  */
     class APPROXMVBB_EXPORT ConvexHull2D
     {
@@ -34,6 +36,27 @@ namespace ApproxMVBB
         ApproxMVBB_DEFINE_MATRIX_TYPES;
         ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
 
+        /** Scratch buffers of the convex hull computation, which can be reused
+     * for many convex hulls to avoid allocations (see MVBBWorkspace)
+     */
+        struct Buffers
+        {
+            std::vector<std::pair<unsigned int, bool>> m_indices;  ///< Indices into m_p (second = delete flag).
+            std::vector<unsigned int> m_indicesT;                   ///< Sorted indices into m_p.
+            std::vector<unsigned int> m_candidates;                 ///< Hull candidates (QuickHull, parallel hull).
+            std::vector<unsigned int> m_indicesCH;                  ///< Indices of the convex hull.
+            std::vector<std::vector<unsigned int>> m_blockHulls;    ///< Convex hulls of the blocks (parallel hull).
+        };
+
+        /** Convex hull algorithms */
+        enum class Algorithm
+        {
+            GrahamScan,     ///< Graham scan, sorts all points by angle around the lowest point.
+            MonotoneChain,  ///< Andrew's monotone chain, sorts all points by x.
+            QuickHull,      ///< QuickHull filters the hull candidates, monotone chain on the candidates.
+            ParallelMonotoneChain  ///< Monotone chain on blocks in parallel, merged with a monotone chain.
+        };
+
         /** Cosntructor, points is not a temporary, it accepts all sorts of matrix
      * expressions,
      * however the construction of MatrixRef<> might create a temporary but
@@ -41,7 +64,14 @@ namespace ApproxMVBB
      */
         template<typename Derived>
         ConvexHull2D(const MatrixBase<Derived>& points)
-            : m_p(points)
+            : ConvexHull2D(points, m_ownBuffers)
+        {
+        }
+
+        /** Cosntructor which uses the scratch buffers `buffers` instead of its own ones */
+        template<typename Derived>
+        ConvexHull2D(const MatrixBase<Derived>& points, Buffers& buffers)
+            : m_buffers(buffers), m_indicesCH(buffers.m_indicesCH), m_p(points)
         {
             EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 2, Eigen::Dynamic);
             ApproxMVBB_ASSERTMSG(m_p.data() == points.derived().data(),
@@ -49,10 +79,26 @@ namespace ApproxMVBB
                                  "but do you really want this?")
         }
 
+        ConvexHull2D(const ConvexHull2D&) = delete;
+        ConvexHull2D& operator=(const ConvexHull2D&) = delete;
+
+        /** Graham scan */
         void compute();
 
+        void compute(Algorithm algorithm);
+
+        /** Andrew's monotone chain */
         void computeMonotonChain();
 
+        /** QuickHull (output-sensitive) */
+        void computeQuickHull();
+
+        /** Parallel monotone chain: the points are split into `nBlocks` blocks (default: number of threads)
+         * whose convex hulls are computed concurrently. The hull vertices of all blocks are merged with a
+         * monotone chain. The result is identical to computeMonotonChain().
+         */
+        void computeParallel(unsigned int nBlocks = 0);
+
         bool verifyHull();
 
         inline std::vector<unsigned int>& getIndices()
@@ -61,9 +107,23 @@ namespace ApproxMVBB
         }
 
     private:
-        void chainHull();
+        /** Monotone chain on the indices [begin,end) which are sorted by lessXY, the hull is written to `hull` */
+        template<typename Iterator>
+        void chainHull(Iterator begin, Iterator end, std::vector<unsigned int>& hull) const;
+
+        /** Removes almost equal consecutive points and starts the hull at the lowest point */
+        void finalizeHull();
+
+        /** Lexicographic order of the points (by x, then y, equal points by index) */
+        inline bool lessXY(unsigned int a, unsigned int b) const
+        {
+            return m_p(0, a) < m_p(0, b) ||
+                   (m_p(0, a) == m_p(0, b) && (m_p(1, a) < m_p(1, b) || (m_p(1, a) == m_p(1, b) && a < b)));
+        }
 
-        std::vector<unsigned int> m_indicesCH;
+        Buffers m_ownBuffers;
+        Buffers& m_buffers;
+        std::vector<unsigned int>& m_indicesCH;
         const MatrixRef<const Matrix2Dyn> m_p;
     };
 }  // namespace ApproxMVBB
@@ -0,0 +1,142 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz
+//  (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#ifndef ApproxMVBB_ConvexHull3D_hpp
+#define ApproxMVBB_ConvexHull3D_hpp
+
+#include <array>
+#include <vector>
+
+#include "ApproxMVBB/Config/Config.hpp"
+#include ApproxMVBB_TypeDefs_INCLUDE_FILE
+#include "ApproxMVBB/Common/TypeDefsPoints.hpp"
+
+namespace ApproxMVBB
+{
+    /** Convex hull of 3D points (QuickHull).
+     * The hull is computed with the tolerance `getTolerance()` (relative to the coordinate
+     * magnitude): points closer than the tolerance to the hull are treated as inside, thus
+     * all input points lie inside the hull up to the tolerance.
+     * Coplanar point sets are handled with ConvexHull2D in the plane, collinear ones by the
+     * two end points. Point sets thinner than `sqrt(epsilon)` times their extent count as
+     * coplanar (collinear), their faces would have inaccurate normals.
+     * Function getVertexIndices() returns the ascending indices of the points which span the hull,
+     * which is all that matters for any bounding box of the points.
+     * If round-off breaks the hull (the horizon of a point is not a closed cycle), the
+     * computation stops and all points are returned as vertices without faces.
+     */
+    class APPROXMVBB_EXPORT ConvexHull3D
+    {
+    public:
+        ApproxMVBB_DEFINE_MATRIX_TYPES;
+        ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
+
+        using Face = std::array<unsigned int, 3>;  ///< Triangle (counter-clockwise seen from outside).
+
+        /** Constructor, `points` is referenced without copy if it is a matrix (or a map)
+            of type PREC, other expressions are evaluated into a copy held by the hull. */
+        template<typename Derived>
+        ConvexHull3D(const MatrixBase<Derived>& points)
+            : m_p(points)
+        {
+            EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
+        }
+
+        ConvexHull3D(const ConvexHull3D&) = delete;
+        ConvexHull3D& operator=(const ConvexHull3D&) = delete;
+
+        /** QuickHull */
+        void compute();
+
+        /** Checks that all points are inside of all faces (up to a few times the tolerance) */
+        bool verifyHull() const;
+
+        /** Ascending indices of the hull vertices */
+        inline const std::vector<unsigned int>& getVertexIndices() const
+        {
+            return m_vertices;
+        }
+
+        /** Faces of the hull (empty for coplanar or collinear points) */
+        inline const std::vector<Face>& getFaces() const
+        {
+            return m_faces;
+        }
+
+        /** Copy the hull vertices into `vertices` (3 x number of vertices) */
+        void getVertices(Matrix3Dyn& vertices) const;
+
+        /** Copy the hull vertices into `vertices` (see getVertices) and the faces into `faces`
+            with indices into `vertices` instead of the points */
+        void getHull(Matrix3Dyn& vertices, std::vector<Face>& faces) const;
+
+        inline PREC getTolerance() const
+        {
+            return m_tolerance;
+        }
+
+    private:
+        struct HullFace
+        {
+            Face m_v;                        ///< Vertices.
+            std::array<int, 3> m_neighbors;  ///< Neighbor face over edge `m_v[i] -> m_v[i+1]`.
+            Vector3 m_normal;                ///< Outward unit normal.
+            PREC m_offset;                   ///< Plane `m_normal * p = m_offset`.
+            int m_outside  = -1;             ///< First point of the outside list (see m_nextOutside).
+            bool m_deleted = false;          ///< Face has been replaced.
+        };
+
+        /** Signed distance of point `i` to the plane of `face` */
+        inline PREC distance(const HullFace& face, unsigned int i) const
+        {
+            return face.m_normal.dot(m_p.col(i)) - face.m_offset;
+        }
+
+        int addFace(unsigned int a, unsigned int b, unsigned int c);
+
+        /** Add point `i` to the outside list of the face (of the faces `[first,end)`) it is
+            farthest outside of. Returns false if it is inside of all faces */
+        bool assignOutside(unsigned int i, std::size_t first, std::size_t end);
+
+        /** Find the visible faces from point `eye` starting at `face` and the horizon edges
+            in counter-clockwise order (iteratively, the number of visible faces is unbounded).
+            Returns false if the horizon is not a closed cycle (round-off) */
+        bool computeHorizon(unsigned int eye, int face);
+
+        /** Fallback for points in a plane or on a line */
+        void computeDegenerate(unsigned int i0, unsigned int i1, unsigned int i2, bool collinear);
+
+        struct HorizonEdge
+        {
+            unsigned int m_a, m_b;  ///< Edge `a -> b` of a visible face.
+            int m_face;             ///< Non-visible neighbor face.
+            int m_edge;             ///< Index of the edge `b -> a` in the neighbor face.
+        };
+
+        struct HorizonStep
+        {
+            int m_face;   ///< Visible face.
+            int m_edge;   ///< Next edge to continue over.
+            int m_count;  ///< Number of edges left.
+        };
+
+        PREC m_tolerance = 0;
+        StdVecAligned<HullFace> m_hullFaces;
+        std::vector<int> m_nextOutside;  ///< Linked lists of the outside points of the faces.
+        std::vector<int> m_visible;      ///< Visible faces of the current point.
+        std::vector<HorizonEdge> m_horizon;
+        std::vector<HorizonStep> m_horizonStack;  ///< Stack of the horizon walk.
+
+        std::vector<unsigned int> m_vertices;
+        std::vector<Face> m_faces;
+        const MatrixRef<const Matrix3Dyn> m_p;
+    };
+}  // namespace ApproxMVBB
+#endif
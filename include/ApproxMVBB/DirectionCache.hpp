@@ -0,0 +1,197 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz
+//  (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#ifndef ApproxMVBB_DirectionCache_hpp
+#define ApproxMVBB_DirectionCache_hpp
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "ApproxMVBB/Config/Config.hpp"
+#include ApproxMVBB_TypeDefs_INCLUDE_FILE
+#include ApproxMVBB_OOBB_INCLUDE_FILE
+#include "ApproxMVBB/ProjectedPointSet.hpp"
+
+namespace ApproxMVBB
+{
+    /**
+        Cache of the boxes ProjectedPointSet::computeMVBB computed for the directions of one
+        grid search (see approximateMVBBGridSearch with a MVBBWorkspace).
+        The directions are normalized, quantised with `resolution` and `dir` and `-dir`
+        are mapped to the same key, such that equivalent directions (e.g. the directions of
+        optimizeMVBB after many candidates converged to the same box) are projected only once.
+        The grid itself contains no opposite directions (see details::primitiveGridDirections).
+
+        The default `resolution = 1e-10` only merges directions which are equal up to
+        round-off, i.e. exact opposites and repeated directions, it does not merge
+        near-parallel directions.
+        A coarser `resolution` merges all directions whose normalized components round
+        to the same multiples of `resolution` (an angle below about `1.8 * resolution`)
+        and returns the box of the first of them. That box still contains all points,
+        but its volume differs from the box of the requested direction: tilting a box
+        with extents `a >= b >= c` by an angle `phi` grows its volume by up to a factor
+        of about `(1 + phi * a / c)^2`. Choose `resolution` well below `epsilon * c / a`
+        of the search to keep this error below the accuracy of the result.
+        The cache is an open addressing hash table over a vector of entries, `clear()`
+        keeps the memory (no allocations in steady state).
+
+        The cache is disabled by default: a cached box can differ from the recomputed one
+        by round-off (or by the orientation of its axes for `-dir`), which changes the result
+        of the grid search in degenerate cases where many boxes have the same volume.
+        A disabled cache computes every box and counts it as miss.
+    */
+    class DirectionCache
+    {
+    public:
+        ApproxMVBB_DEFINE_MATRIX_TYPES;
+        ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
+
+        explicit DirectionCache(bool enabled = false, PREC resolution = 1e-10)
+            : m_enabled(enabled), m_resolution(resolution)
+        {
+        }
+
+        inline void setEnabled(bool enabled)
+        {
+            m_enabled = enabled;
+        }
+
+        inline bool isEnabled() const
+        {
+            return m_enabled;
+        }
+
+        /** Remove all directions (the points changed) and reset the counters. */
+        void clear()
+        {
+            m_entries.clear();
+            std::fill(m_table.begin(), m_table.end(), emptySlot());
+            m_hits   = 0;
+            m_misses = 0;
+        }
+
+        /** Returns the box `proj.computeMVBB(dir, points)`, or the cached box if an
+            equivalent direction has been computed since the last `clear()`. */
+        template<typename Derived>
+        OOBB computeMVBB(ProjectedPointSet& proj, const Vector3& dir, const MatrixBase<Derived>& points)
+        {
+            if(!m_enabled)
+            {
+                ++m_misses;
+                return proj.computeMVBB(dir, points);
+            }
+
+            Key key = makeKey(dir);
+            if(2 * (m_entries.size() + 1) > m_table.size())
+            {
+                grow();
+            }
+
+            std::size_t slot = findSlot(key);
+            if(m_table[slot] != emptySlot())
+            {
+                ++m_hits;
+                return m_entries[m_table[slot]].m_oobb;
+            }
+
+            ++m_misses;
+            m_table[slot] = m_entries.size();
+            m_entries.push_back(Entry{key, proj.computeMVBB(dir, points)});
+            return m_entries.back().m_oobb;
+        }
+
+        /** Number of directions answered from the cache since the last `clear()`. */
+        inline std::size_t hits() const
+        {
+            return m_hits;
+        }
+
+        /** Number of directions projected since the last `clear()`. */
+        inline std::size_t misses() const
+        {
+            return m_misses;
+        }
+
+    private:
+        using Key = std::array<long long int, 3>;
+
+        struct Entry
+        {
+            Key m_key;
+            OOBB m_oobb;
+        };
+
+        static constexpr std::size_t emptySlot()
+        {
+            return static_cast<std::size_t>(-1);
+        }
+
+        /** Quantised unit direction, the sign is chosen such that the first non-zero component is positive. */
+        Key makeKey(const Vector3& dir) const
+        {
+            Vector3 d = dir.normalized() / m_resolution;
+            Key key   = {{std::llround(d(0)), std::llround(d(1)), std::llround(d(2))}};
+
+            auto first = std::find_if(key.begin(), key.end(), [](long long int v) { return v != 0; });
+            if(first != key.end() && *first < 0)
+            {
+                for(auto& v : key)
+                {
+                    v = -v;
+                }
+            }
+            return key;
+        }
+
+        static std::size_t hash(const Key& key)
+        {
+            std::uint64_t h = 0;
+            for(auto v : key)
+            {
+                h ^= static_cast<std::uint64_t>(v) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+            }
+            return static_cast<std::size_t>(h);
+        }
+
+        /** Slot of `key` in the table, or the empty slot where it belongs (linear probing). */
+        std::size_t findSlot(const Key& key) const
+        {
+            std::size_t mask = m_table.size() - 1;
+            std::size_t slot = hash(key) & mask;
+            while(m_table[slot] != emptySlot() && m_entries[m_table[slot]].m_key != key)
+            {
+                slot = (slot + 1) & mask;
+            }
+            return slot;
+        }
+
+        /** Double the table size (power of two) and reinsert all entries. */
+        void grow()
+        {
+            m_table.assign(std::max<std::size_t>(64, 2 * m_table.size()), emptySlot());
+            for(std::size_t i = 0; i < m_entries.size(); ++i)
+            {
+                m_table[findSlot(m_entries[i].m_key)] = i;
+            }
+        }
+
+        bool m_enabled;                    ///< Look up the directions in the cache.
+        PREC m_resolution;                 ///< Quantisation of the unit directions.
+        StdVecAligned<Entry> m_entries;    ///< Cached boxes.
+        std::vector<std::size_t> m_table;  ///< Hash table of indices into m_entries.
+        std::size_t m_hits   = 0;          ///< Number of cache hits.
+        std::size_t m_misses = 0;          ///< Number of computed boxes.
+    };
+}  // namespace ApproxMVBB
+
+#endif
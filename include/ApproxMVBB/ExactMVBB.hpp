@@ -0,0 +1,74 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz
+//  (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#ifndef ApproxMVBB_ExactMVBB_hpp
+#define ApproxMVBB_ExactMVBB_hpp
+
+#include <vector>
+
+#include "ApproxMVBB/Config/Config.hpp"
+#include ApproxMVBB_TypeDefs_INCLUDE_FILE
+#include ApproxMVBB_AssertionDebug_INCLUDE_FILE
+#include ApproxMVBB_OOBB_INCLUDE_FILE
+#include "ApproxMVBB/ConvexHull3D.hpp"
+
+namespace ApproxMVBB
+{
+    ApproxMVBB_DEFINE_MATRIX_TYPES;
+    ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
+
+    namespace details
+    {
+        /** Minimum volume box of the convex hull with the vertices `vertices` and the triangles `faces`
+            (indices into `vertices`, counter-clockwise seen from outside), see exactMVBB.
+            Empty `faces` means the vertices are coplanar or collinear. */
+        APPROXMVBB_EXPORT OOBB exactMVBBOfHull(const Matrix3Dyn& vertices,
+                                               const std::vector<ConvexHull3D::Face>& faces);
+    }  // namespace details
+
+    /*!
+        Computes the minimum volume bounding box of the points `points` (O'Rourke).
+        The box only depends on the convex hull (ConvexHull3D) and has either
+        - a face flush with a hull face: each hull face normal is a candidate direction, or
+        - two adjacent faces flush with two hull edges `e1,e2`: the normal of the first face
+          moves on the arc of normals of `e1` (between the normals of the two hull faces at `e1`),
+          the normal of the second face is perpendicular to it and to `e2` and has to lie on the arc
+          of `e2`. The feasible intervals of the arc of `e1` are computed in closed form and split
+          where the vertices touching the other box faces change. On each piece the volume is a
+          rational function of the angle and its stationary points are the roots of a polynomial
+          of degree 7, the common edge direction of the two faces at the minimum is a candidate
+          direction (pairs with `e1 == e2` give the edge directions themselves).
+
+        The box in each candidate direction is computed with the minimal area rectangle
+        (ProjectedPointSet::computeMVBB), the smallest of them is returned.
+        The edge pairs are distributed over all threads (OpenMP).
+        The cost grows with the square of the number of hull edges, this is meant as a reference
+        for approximateMVBB on moderate hulls (a few thousand vertices) and not as replacement.
+    */
+    template<typename Derived>
+    OOBB exactMVBB(const MatrixBase<Derived>& points)
+    {
+        EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
+        if(points.cols() == 0)
+        {
+            ApproxMVBB_ERRORMSG("Point set is empty!");
+        }
+
+        ConvexHull3D hull(points);
+        hull.compute();
+
+        Matrix3Dyn vertices;
+        std::vector<ConvexHull3D::Face> faces;
+        hull.getHull(vertices, faces);
+        return details::exactMVBBOfHull(vertices, faces);
+    }
+}  // namespace ApproxMVBB
+
+#endif
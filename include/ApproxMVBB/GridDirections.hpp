@@ -0,0 +1,38 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz
+//  (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#ifndef ApproxMVBB_GridDirections_hpp
+#define ApproxMVBB_GridDirections_hpp
+
+#include <array>
+#include <vector>
+
+#include "ApproxMVBB/Config/Config.hpp"
+#include ApproxMVBB_Platform_INCLUDE_FILE
+
+namespace ApproxMVBB
+{
+    namespace details
+    {
+        using GridDirection = std::array<int, 3>;
+
+        /** Primitive lattice directions `(x,y,z)` of the grid search in approximateMVBBGridSearch:
+            `x,y` in `[-gridSize,gridSize]`, `z` in `[0,gridSize]` and `gcd3(x,y,z) == 1`
+            (in the order of the loops over `x`, `y`, `z`).
+            Of the opposite directions `(x,y,0)` and `(-x,-y,0)`, which have the same box, only the
+            one with `y > 0` (or `y == 0, x > 0`) is contained. Hence the grid search with equal volumes
+            of both keeps the box of the remaining direction (the earlier one in the loop before).
+            The table is computed once per `gridSize` (thread-safe) and the returned
+            reference stays valid for the lifetime of the program. */
+        APPROXMVBB_EXPORT const std::vector<GridDirection>& primitiveGridDirections(unsigned int gridSize);
+    }  // namespace details
+}  // namespace ApproxMVBB
+
+#endif
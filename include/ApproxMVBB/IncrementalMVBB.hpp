@@ -0,0 +1,238 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz
+//  (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#ifndef ApproxMVBB_IncrementalMVBB_hpp
+#define ApproxMVBB_IncrementalMVBB_hpp
+
+#include <algorithm>
+#include <limits>
+
+#include "ApproxMVBB/Config/Config.hpp"
+#include ApproxMVBB_TypeDefs_INCLUDE_FILE
+#include ApproxMVBB_OOBB_INCLUDE_FILE
+#include "ApproxMVBB/ComputeApproxMVBB.hpp"
+#include "ApproxMVBB/ConvexHull3D.hpp"
+#include "ApproxMVBB/MVBBWorkspace.hpp"
+#include "ApproxMVBB/ProjectedPointSet.hpp"
+
+namespace ApproxMVBB
+{
+    /**
+        Approximate MVBB of a growing point set (e.g. a few hundred points per frame).
+        The first `add` computes the box with approximateMVBB, afterwards the object keeps
+        - the 2d convex hull candidates in the projection direction `z` of the current box
+          (see ProjectedPointSet::addMVBBStreaming) and
+        - the grid sample of samplePointsGrid (see details::StreamingSampleGrid).
+
+        Each `add` registers the new points in both and tests them against the current box
+        (OOBB::overlaps). Only if points fall outside, the minimal box in direction `z` is
+        recomputed from the hull candidates. Only if its volume exceeds `volumeDegradation`
+        times the volume after the last grid search, the grid search of approximateMVBB is
+        repeated on the sample (which changes the direction `z` if a smaller box is found).
+        The cost of an `add` is therefore proportional to the new points (plus the hull
+        candidates if the box grows).
+
+        The box contains all added points (it is expanded by the round-off error of the
+        projection): the object also retains the vertices of the 3d convex hull of all points
+        (the new points are appended and the hull is recomputed with ConvexHull3D whenever the
+        retained points doubled), and after a change of direction the box is refit over them.
+    */
+    class IncrementalMVBB
+    {
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        ApproxMVBB_DEFINE_MATRIX_TYPES;
+        ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
+
+        /** See approximateMVBB for the parameters.
+            @param volumeDegradation is the factor by which the volume may grow before the
+                   grid search is repeated. */
+        IncrementalMVBB(const PREC epsilon,
+                        const unsigned int pointSamples           = 400,
+                        const unsigned int gridSize               = 5,
+                        const unsigned int mvbbGridSearchOptLoops = 6,
+                        const PREC volumeDegradation              = 1.1,
+                        std::size_t seed                          = ApproxMVBB::RandomGenerators::defaultSeed)
+            : m_epsilon(epsilon)
+            , m_pointSamples(pointSamples)
+            , m_gridSize(gridSize)
+            , m_gridSearchOptLoops(mvbbGridSearchOptLoops)
+            , m_volumeDegradation(volumeDegradation)
+            , m_seed(seed)
+        {
+            if(pointSamples < 2 || volumeDegradation < 1)
+            {
+                ApproxMVBB_ERRORMSG("Wrong arguments! sample points: (>=2) " << pointSamples
+                                                                              << ", volume degradation (>=1): "
+                                                                              << volumeDegradation);
+            }
+        }
+
+        /** Add the points `points` and update the box. */
+        template<typename Derived>
+        void add(const MatrixBase<Derived>& points)
+        {
+            EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
+
+            auto size = points.cols();
+            if(size == 0)
+            {
+                return;
+            }
+
+            if(m_nPoints == 0)
+            {
+                m_nPoints = static_cast<std::size_t>(size);
+                m_oobb    = approximateMVBB(
+                    points, m_workspace, m_epsilon, m_pointSamples, m_gridSize, 0, m_gridSearchOptLoops, m_seed);
+                retain(points);
+                reset(points);
+                return;
+            }
+            m_nPoints += static_cast<std::size_t>(size);
+            retain(points);
+
+            m_workspace.m_proj.addMVBBStreaming(points);
+            m_grid.add(points);
+
+            // Test the new points against the current box
+            Matrix33 A_KI = m_oobb.m_q_KI.matrix().transpose();
+            Vector3 K_p;
+            bool outside = false;
+            for(decltype(size) i = 0; i < size && !outside; ++i)
+            {
+                K_p     = A_KI * points.col(i);
+                outside = !m_oobb.overlaps<Vector3, false>(K_p);
+            }
+            if(!outside)
+            {
+                return;
+            }
+
+            // Minimal box in the current direction
+            fit();
+            if(m_oobb.volume() <= m_volumeDegradation * m_optimizedVolume)
+            {
+                return;
+            }
+
+            // Grid search on the sample
+            ++m_nGridSearches;
+            m_grid.getSample(m_sample);
+            OOBB oobb = approximateMVBBGridSearch(
+                m_sample, m_oobb, m_workspace, m_epsilon, m_gridSize, m_gridSearchOptLoops);
+
+            if(oobb.volume() < m_oobb.volume())
+            {
+                // New direction: refit over the retained points and resample the sample
+                // (taken after adding `points` to the grid, thus it already represents them)
+                m_oobb = oobb;
+                reset(m_sample);
+            }
+            else
+            {
+                m_optimizedVolume = m_oobb.volume();
+            }
+        }
+
+        /** Get the current box. */
+        inline const OOBB& getOOBB() const
+        {
+            return m_oobb;
+        }
+
+        /** Get the number of added points. */
+        inline std::size_t size() const
+        {
+            return m_nPoints;
+        }
+
+        /** Get the number of repeated grid searches. */
+        inline std::size_t gridSearches() const
+        {
+            return m_nGridSearches;
+        }
+
+    private:
+        /** Set the box to the minimal box of the hull candidates in the current direction,
+            which is expanded by the round-off error of the projection */
+        void fit()
+        {
+            m_oobb = m_workspace.m_proj.endMVBBStreaming();
+            PREC magnitude =
+                std::max(m_oobb.m_minPoint.cwiseAbs().maxCoeff(), m_oobb.m_maxPoint.cwiseAbs().maxCoeff());
+            m_oobb.expand(16 * std::numeric_limits<PREC>::epsilon() * magnitude);
+        }
+
+        /** Append `points` to the retained points and reduce these to the vertices of their
+            convex hull if their number doubled since the last reduction. */
+        template<typename Derived>
+        void retain(const MatrixBase<Derived>& points)
+        {
+            auto size = points.cols();
+            if(m_nRetained + size > m_retained.cols())
+            {
+                m_retained.conservativeResize(3, std::max(2 * m_retained.cols(), m_nRetained + size));
+            }
+            m_retained.middleCols(m_nRetained, size) = points;
+            m_nRetained += size;
+
+            if(m_nRetained < 2 * std::max<decltype(size)>(m_nHullVertices, m_pointSamples))
+            {
+                return;
+            }
+            ConvexHull3D hull(m_retained.leftCols(m_nRetained));
+            hull.compute();
+            const auto& vertices = hull.getVertexIndices();  // ascending, thus copied in place
+            for(std::size_t k = 0; k < vertices.size(); ++k)
+            {
+                m_retained.col(k) = m_retained.col(vertices[k]);
+            }
+            m_nRetained = m_nHullVertices = static_cast<decltype(size)>(vertices.size());
+        }
+
+        /** Start over in the direction `z` of m_oobb: the box becomes the minimal box of the
+            retained points in this direction and the grid samples `points`. */
+        template<typename Derived>
+        void reset(const MatrixBase<Derived>& points)
+        {
+            ProjectedPointSet& proj = m_workspace.m_proj;
+            proj.beginMVBBStreaming(m_oobb.getDirection(2));
+            proj.addMVBBStreaming(m_retained.leftCols(m_nRetained));
+            fit();
+            m_optimizedVolume = m_oobb.volume();
+
+            OOBB gridBox = m_oobb;
+            gridBox.expandToMinExtentAbsolute(1e-12);
+            m_grid.reset(m_pointSamples, gridBox, m_seed);
+            m_grid.add(points);
+        }
+
+        PREC m_epsilon;
+        unsigned int m_pointSamples;
+        unsigned int m_gridSize;
+        unsigned int m_gridSearchOptLoops;
+        PREC m_volumeDegradation;
+        std::size_t m_seed;
+
+        OOBB m_oobb;                          ///< Current box.
+        PREC m_optimizedVolume = 0;           ///< Volume after the last grid search.
+        MVBBWorkspace m_workspace;            ///< Buffers and the 2d hull candidates (m_workspace.m_proj).
+        details::StreamingSampleGrid m_grid;  ///< Grid sample of all points.
+        Matrix3Dyn m_sample;                  ///< Sample for the grid search.
+        Matrix3Dyn m_retained;                ///< Hull vertices of the points and the points added since.
+        Eigen::Index m_nRetained     = 0;     ///< Number of retained points (columns of m_retained).
+        Eigen::Index m_nHullVertices = 0;     ///< Number of retained points after the last reduction.
+        std::size_t m_nPoints       = 0;      ///< Number of added points.
+        std::size_t m_nGridSearches = 0;      ///< Number of repeated grid searches.
+    };
+}  // namespace ApproxMVBB
+
+#endif
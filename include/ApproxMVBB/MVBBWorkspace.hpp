@@ -0,0 +1,86 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz
+//  (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#ifndef ApproxMVBB_MVBBWorkspace_hpp
+#define ApproxMVBB_MVBBWorkspace_hpp
+
+#include <vector>
+
+#include "ApproxMVBB/Config/Config.hpp"
+#include ApproxMVBB_TypeDefs_INCLUDE_FILE
+#include "ApproxMVBB/Common/TypeDefsPoints.hpp"
+#include "ApproxMVBB/DirectionCache.hpp"
+#include "ApproxMVBB/ProjectedPointSet.hpp"
+
+namespace ApproxMVBB
+{
+    namespace details
+    {
+        /** Grid cell in samplePointsGrid, which stores the bottom/top point in z-direction
+            (indices start from 1, 0 means the cell is empty) */
+        struct BottomTopPoints
+        {
+            ApproxMVBB_DEFINE_MATRIX_TYPES;
+            ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
+            using IndexType = Matrix3Dyn::Index;
+
+            IndexType bottomIdx = 0;
+            PREC bottomZ;
+
+            IndexType topIdx = 0;
+            PREC topZ;
+        };
+
+        /** Buffers of samplePointsGrid and of the padding strategies (see SamplePadding) */
+        struct SampleGridBuffers
+        {
+            ApproxMVBB_DEFINE_MATRIX_TYPES;
+            using IndexType = Matrix3Dyn::Index;
+
+            std::vector<BottomTopPoints> m_cells;  ///< Grid cells (one grid per chunk of points).
+            std::vector<char> m_marker;            ///< Marks the sampled points (only set during the sampling).
+            std::vector<IndexType> m_selected;     ///< Sampled point indices (to reset m_marker).
+
+            std::vector<IndexType> m_candidates;  ///< Random candidate pool (PoissonDisk, FarthestPoint).
+            std::vector<IndexType> m_reservoirs;  ///< Reservoirs of the cells (StratifiedReservoir).
+            std::vector<std::size_t> m_seen;      ///< Number of points seen per cell (StratifiedReservoir).
+            std::vector<PREC> m_distances;        ///< Squared distances of the candidates (FarthestPoint).
+            std::vector<int> m_diskTable;         ///< Hash table of the first point per slot (PoissonDisk).
+            std::vector<int> m_diskNext;          ///< Next point in the same slot (PoissonDisk).
+            StdVecAligned<Vector3> m_diskPoints;  ///< Sample points in the hash grid (PoissonDisk).
+        };
+    }  // namespace details
+
+    /** Scratch buffers for the MVBB algorithms in ComputeApproxMVBB.hpp.
+        Passing the same workspace to many calls (e.g. computing the bounding boxes
+        of many small point clouds) reuses all buffers instead of allocating new ones.
+        Once the buffers have grown to the largest point cloud, repeated calls do not allocate.
+        A workspace must not be shared between threads.
+    */
+    class MVBBWorkspace
+    {
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        ApproxMVBB_DEFINE_MATRIX_TYPES;
+        ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
+
+        ProjectedPointSet m_proj;                            ///< Projection, convex hull and rectangle buffers.
+        Matrix3Dyn m_sampled;                                ///< Representative sample for the grid search.
+        Matrix3Dyn m_hullVertices;                           ///< Vertices of the 3d convex hull (see approximateMVBB).
+        details::SampleGridBuffers m_sampleGrid;             ///< Grid for the sampling of the points.
+        DiameterEstimator m_diameterEstimator;               ///< Estimator for the 3d diameter.
+        Matrix3Dyn m_diameterPoints;                         ///< Evaluated points for the 3d diameter (expression input).
+        DirectionCache m_directionCache;                     ///< Boxes of the directions of the last grid search.
+        std::size_t m_gridDirections   = 0;                  ///< Number of directions of the last grid search.
+        std::size_t m_prunedDirections = 0;                  ///< Number of pruned directions of the last grid search.
+    };
+}  // namespace ApproxMVBB
+
+#endif
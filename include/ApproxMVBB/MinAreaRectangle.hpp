@@ -40,9 +40,24 @@ namespace ApproxMVBB
      * this is stored in m_p!
      * MatrixRef<>  m_p is handed further to m_conv
      */
+        /** Scratch buffers of the minimum area rectangle computation, which can be
+     * reused for many rectangles to avoid allocations (see MVBBWorkspace)
+     */
+        struct Buffers
+        {
+            ConvexHull2D::Buffers m_convexHull;  ///< Buffers for the convex hull.
+        };
+
         template<typename Derived>
         MinAreaRectangle(const MatrixBase<Derived>& points)
-            : m_p(points), m_convh(m_p)
+            : MinAreaRectangle(points, m_ownBuffers)
+        {
+        }
+
+        /** Cosntructor which uses the scratch buffers `buffers` instead of its own ones */
+        template<typename Derived>
+        MinAreaRectangle(const MatrixBase<Derived>& points, Buffers& buffers)
+            : m_p(points), m_convh(m_p, buffers.m_convexHull), m_hullIdx(m_convh.getIndices())
         {
             EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 2, Eigen::Dynamic);
             ApproxMVBB_ASSERTMSG(m_p.data() == points.derived().data(),
@@ -78,20 +93,14 @@ namespace ApproxMVBB
             return m_minBox;
         }
 
-        void compute();
+        /** Computes the minimum area rectangle, the convex hull is computed with `algorithm` */
+        void compute(ConvexHull2D::Algorithm algorithm = ConvexHull2D::Algorithm::GrahamScan);
 
     private:
         using Vector2U = MyMatrix::Vector2<unsigned int>;
 
         void computeRectangle();
 
-        struct Caliper
-        {
-            unsigned int m_idx   = 0;  // index in m_hullIdx
-            unsigned int m_ptIdx = 0;  // index in m_p
-            PREC m_currAngle     = 0.0;
-        };
-
         inline void adjustRectangle()
         {
             // The rectangle might be a slight parallelogram due to numerics
@@ -185,44 +194,17 @@ namespace ApproxMVBB
             }
         }
 
-        inline void updateCalipers(PREC edgeAngle, Caliper (&c)[4])
-        {
-            updateAngles(edgeAngle, c);
-            for(unsigned char i = 0; i < 4; i++)
-            {
-                findVertex(c[i]);
-            }
-        }
-
-        // determine caliper angles according to the box given with c[0].m_currAngle =
-        // edgeAngle;
-        inline void updateAngles(PREC edgeAngle, Caliper (&c)[4])
-        {
-            c[0].m_currAngle = AngleFunctions::mapTo2Pi(edgeAngle);
-            c[1].m_currAngle = AngleFunctions::mapTo2Pi(c[0].m_currAngle + 0.5 * M_PI);
-            c[2].m_currAngle = AngleFunctions::mapTo2Pi(c[1].m_currAngle + 0.5 * M_PI);
-            c[3].m_currAngle = AngleFunctions::mapTo2Pi(c[2].m_currAngle + 0.5 * M_PI);
-
-            //        std::cout << "caliper 1 angle:" <<  c[0].m_currAngle << std::endl;
-            //        std::cout << "caliper 2 angle:" <<  c[1].m_currAngle << std::endl;
-            //        std::cout << "caliper 3 angle:" <<  c[2].m_currAngle << std::endl;
-            //        std::cout << "caliper 4 angle:" <<  c[3].m_currAngle << std::endl;
-        }
-
-        // determine the vertex v for which the edge angle is greater than
-        // c.m_currAngle
-        // the find algroithm starts at c.m_idx
-        void findVertex(Caliper& c);
-
-        void getBox(Caliper (&c)[4], Box2d& box);
+        /** Box of the calipers at the hull vertices a (with edge e = p[a+1]-p[a]), b, c, d
+         *  (indices into m_hullIdx) */
+        void getBox(unsigned int a, unsigned int b, unsigned int c, unsigned int d, const Vector2& e, Box2d& box);
 
-        std::vector<unsigned int> m_hullIdx;
+        Buffers m_ownBuffers;
 
-        std::vector<PREC> m_angles;
         Box2d m_minBox;
         const MatrixRef<const Matrix2Dyn> m_p;
 
         ConvexHull2D m_convh;
+        const std::vector<unsigned int>& m_hullIdx;  ///< Indices of the convex hull (from m_convh).
     };
 }  // namespace ApproxMVBB
 #endif
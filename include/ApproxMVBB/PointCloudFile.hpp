@@ -0,0 +1,195 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz
+//  (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#ifndef ApproxMVBB_PointCloudFile_hpp
+#define ApproxMVBB_PointCloudFile_hpp
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "ApproxMVBB/Config/Config.hpp"
+#include ApproxMVBB_TypeDefs_INCLUDE_FILE
+#include ApproxMVBB_AssertionDebug_INCLUDE_FILE
+#include ApproxMVBB_StaticAssert_INCLUDE_FILE
+
+namespace ApproxMVBB
+{
+    ApproxMVBB_DEFINE_MATRIX_TYPES;
+    ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
+
+    /**
+        Binary point cloud file format (all header fields in the byte order given by `m_bigEndian`):
+
+        | offset | size | field                                                     |
+        |--------|------|-----------------------------------------------------------|
+        |      0 |    8 | magic `"AMVBBPTS"`                                        |
+        |      8 |    1 | `m_bigEndian` : 1 if the file is big endian, 0 otherwise  |
+        |      9 |    1 | `m_scalarBytes` : 4 (float) or 8 (double)                 |
+        |     10 |    2 | `m_version` : 1                                           |
+        |     12 |    4 | `m_dimension` : number of coordinates per point           |
+        |     16 |    8 | `m_count` : number of points                              |
+        |     24 |    8 | `m_dataOffset` : byte offset of the points (usually 32)   |
+
+        The points follow at `m_dataOffset` as a column-major `m_dimension x m_count` matrix,
+        i.e. point after point.
+    */
+    struct PointCloudFileHeader
+    {
+        static const std::uint16_t currentVersion = 1;
+
+        char m_magic[8];
+        std::uint8_t m_bigEndian;
+        std::uint8_t m_scalarBytes;
+        std::uint16_t m_version;
+        std::uint32_t m_dimension;
+        std::uint64_t m_count;
+        std::uint64_t m_dataOffset;
+    };
+
+    ApproxMVBB_STATIC_ASSERTM(sizeof(PointCloudFileHeader) == 32, "PointCloudFileHeader needs to be 32 bytes");
+
+    namespace details
+    {
+        APPROXMVBB_EXPORT bool isBigEndian();
+    }
+
+    /**
+        Read-only memory mapping of a binary point cloud file (see PointCloudFileHeader).
+        The points are accessed without any copy as a `MatrixMap` over the mapped pages, which
+        can be handed directly to `approximateMVBB` and all other functions taking a `MatrixBase`.
+        Only files with the native byte order and the scalar type `PREC` can be mapped.
+    */
+    class APPROXMVBB_EXPORT MappedPointCloud
+    {
+    public:
+        ApproxMVBB_DEFINE_MATRIX_TYPES;
+
+        MappedPointCloud() = default;
+        explicit MappedPointCloud(const std::string& filename)
+        {
+            open(filename);
+        }
+
+        ~MappedPointCloud()
+        {
+            close();
+        }
+
+        MappedPointCloud(const MappedPointCloud&) = delete;
+        MappedPointCloud& operator=(const MappedPointCloud&) = delete;
+
+        MappedPointCloud(MappedPointCloud&& other) noexcept;
+        MappedPointCloud& operator=(MappedPointCloud&& other) noexcept;
+
+        /** Map the file `filename`, throws if the file cannot be mapped or has an invalid header. */
+        void open(const std::string& filename);
+        /** Unmap the file, all maps returned by `points()` are invalid afterwards. */
+        void close();
+
+        inline bool isOpen() const
+        {
+            return m_data != nullptr;
+        }
+
+        inline const PointCloudFileHeader& header() const
+        {
+            return m_header;
+        }
+
+        inline unsigned int dimension() const
+        {
+            return m_header.m_dimension;
+        }
+
+        inline std::size_t size() const
+        {
+            return static_cast<std::size_t>(m_header.m_count);
+        }
+
+        /** Get the points as a `Dimension x size()` map over the mapped file. */
+        template<unsigned int Dimension = 3>
+        MatrixMap<const MatrixStatDyn<Dimension>> points() const
+        {
+            if(!isOpen())
+            {
+                ApproxMVBB_ERRORMSG("MappedPointCloud: no file mapped");
+            }
+            if(m_header.m_dimension != Dimension)
+            {
+                ApproxMVBB_ERRORMSG("MappedPointCloud: file has dimension " << m_header.m_dimension << " and not "
+                                                                            << Dimension);
+            }
+            return MatrixMap<const MatrixStatDyn<Dimension>>(
+                reinterpret_cast<const PREC*>(static_cast<const char*>(m_data) + m_header.m_dataOffset),
+                Dimension,
+                static_cast<typename MatrixStatDyn<Dimension>::Index>(m_header.m_count));
+        }
+
+    private:
+        PointCloudFileHeader m_header = {};  ///< Header of the mapped file.
+
+        void* m_data        = nullptr;  ///< Start of the mapped file.
+        std::size_t m_bytes = 0;        ///< Size of the mapped file.
+#if(defined _WIN32) || (defined WIN32)
+        void* m_file    = nullptr;  ///< File handle.
+        void* m_mapping = nullptr;  ///< File mapping handle.
+#endif
+    };
+
+    /** Write the points `points` (`Dimension x N`) in the binary point cloud format
+        (see PointCloudFileHeader) with the native byte order. */
+    template<typename Derived>
+    void writePointCloudFile(const std::string& filename, const MatrixBase<Derived>& points)
+    {
+        using Scalar = typename Derived::Scalar;
+        ApproxMVBB_STATIC_ASSERTM(sizeof(Scalar) == 4 || sizeof(Scalar) == 8, "only float or double points");
+
+        std::ofstream out(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!out.is_open())
+        {
+            ApproxMVBB_ERRORMSG("cannot open file: " << filename);
+        }
+
+        PointCloudFileHeader header = {};
+        std::memcpy(header.m_magic, "AMVBBPTS", sizeof(header.m_magic));
+        header.m_bigEndian   = details::isBigEndian() ? 1 : 0;
+        header.m_scalarBytes = sizeof(Scalar);
+        header.m_version     = PointCloudFileHeader::currentVersion;
+        header.m_dimension   = static_cast<std::uint32_t>(points.rows());
+        header.m_count       = static_cast<std::uint64_t>(points.cols());
+        header.m_dataOffset  = sizeof(PointCloudFileHeader);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        // Column-major data, point after point
+        MyMatrix::VectorDyn<Scalar> p(points.rows());
+        for(decltype(points.cols()) i = 0; i < points.cols(); ++i)
+        {
+            p = points.col(i);
+            out.write(reinterpret_cast<const char*>(p.data()), sizeof(Scalar) * points.rows());
+        }
+
+        if(!out)
+        {
+            ApproxMVBB_ERRORMSG("could not write file: " << filename);
+        }
+    }
+
+    /** Read the text file `filename` with one point per line (3 whitespace separated values,
+        e.g. `tests/files/Bunny.txt`) into `points`.
+        The file is split into `nChunks` chunks at line boundaries which are parsed in parallel
+        (OpenMP) without iostreams and locale, directly into the preallocated `points`.
+        `nChunks = 0` uses a few chunks per thread. Empty lines are skipped, other lines which
+        do not consist of exactly 3 numbers throw. */
+    APPROXMVBB_EXPORT void readPointCloudText(const std::string& filename, Matrix3Dyn& points, unsigned int nChunks = 0);
+}  // namespace ApproxMVBB
+
+#endif
@@ -12,6 +12,8 @@
 #define ApproxMVBB_PointFunctions_hpp
 
 #include <string>
+#include <type_traits>
+#include <vector>
 #include "ApproxMVBB/Config/Config.hpp"
 #include ApproxMVBB_AssertionDebug_INCLUDE_FILE
 #include ApproxMVBB_StaticAssert_INCLUDE_FILE
@@ -20,6 +22,7 @@
 #include "ApproxMVBB/Common/TypeDefsPoints.hpp"
 #include "ApproxMVBB/Diameter/EstimateDiameter.hpp"
 #include "ApproxMVBB/GeometryPredicates/Predicates.hpp"
+#include "ApproxMVBB/SoAPointsView.hpp"
 
 #ifdef __clang__
 #    pragma clang diagnostic push
@@ -94,8 +97,11 @@ namespace ApproxMVBB
             EIGEN_STATIC_ASSERT_VECTOR_SPECIFIC_SIZE(VecT2, 2);
             EIGEN_STATIC_ASSERT_VECTOR_SPECIFIC_SIZE(VecT3, 2);
 
-            PREC f_A = GeometryPredicates::orient2d(
-                const_cast<double*>(a.data()), const_cast<double*>(b.data()), const_cast<double*>(c.data()));
+            // The robust predicate is evaluated in double (also if PREC is float)
+            double pa[2] = {static_cast<double>(a(0)), static_cast<double>(a(1))};
+            double pb[2] = {static_cast<double>(b(0)), static_cast<double>(b(1))};
+            double pc[2] = {static_cast<double>(c(0)), static_cast<double>(c(1))};
+            double f_A   = GeometryPredicates::orient2d(pa, pb, pc);
 
             return ((f_A < 0.0) ? -1 : ((f_A > 0.0) ? 1 : 0));
         }
@@ -222,39 +228,132 @@ namespace ApproxMVBB
             return index;
         }
 
+        namespace details
+        {
+            /** Coordinates of the points for the DiameterEstimator, which have direct memory access,
+                returns the stride between the points */
+            template<int Dimension, typename Derived>
+            unsigned int diameterCoordinates(const MatrixBase<Derived>& points,
+                                             const PREC* (&coordinates)[Dimension],
+                                             MyMatrix::MatrixStatDyn<PREC, Dimension>&,
+                                             std::true_type)
+            {
+                for(int k = 0; k < Dimension; ++k)
+                {
+                    coordinates[k] = points.derived().data() + k * points.derived().rowStride();
+                }
+                return static_cast<unsigned int>(points.derived().colStride());
+            }
+
+            /** Coordinates of the points evaluated into `evaluated` first */
+            template<int Dimension, typename Derived>
+            unsigned int diameterCoordinates(const MatrixBase<Derived>& points,
+                                             const PREC* (&coordinates)[Dimension],
+                                             MyMatrix::MatrixStatDyn<PREC, Dimension>& evaluated,
+                                             std::false_type)
+            {
+                auto size = points.cols();
+                if(evaluated.cols() < size)
+                {
+                    evaluated.resize(Eigen::NoChange, size);
+                }
+                evaluated.leftCols(size) = points;
+                return diameterCoordinates(evaluated, coordinates, evaluated, std::true_type{});
+            }
+
+            /** Coordinate arrays of a SoAPointsView, which are read in place */
+            inline unsigned int diameterCoordinates(const MatrixBase<SoAPointsView>& points,
+                                                    const PREC* (&coordinates)[3],
+                                                    Matrix3Dyn&,
+                                                    std::false_type)
+            {
+                for(unsigned int k = 0; k < 3; ++k)
+                {
+                    coordinates[k] = points.derived().functor().coordinates(k);
+                }
+                return 1;
+            }
+
+            inline double estimateDiameter(DiameterEstimator& diamEstimator,
+                                           unsigned int* index1,
+                                           unsigned int* index2,
+                                           const PREC* (&coordinates)[2],
+                                           const unsigned int size,
+                                           const unsigned int stride,
+                                           const PREC epsilon)
+            {
+                return diamEstimator.estimateDiameter2D(
+                    index1, index2, coordinates[0], coordinates[1], size, stride, epsilon);
+            }
+
+            inline double estimateDiameter(DiameterEstimator& diamEstimator,
+                                           unsigned int* index1,
+                                           unsigned int* index2,
+                                           const PREC* (&coordinates)[3],
+                                           const unsigned int size,
+                                           const unsigned int stride,
+                                           const PREC epsilon)
+            {
+                return diamEstimator.estimateDiameter3D(
+                    index1, index2, coordinates[0], coordinates[1], coordinates[2], size, stride, epsilon);
+            }
+        }  // namespace details
+
+        /** Estimate the diameter of the 2d or 3d point cloud `points`.
+            The estimator works on a copy of the points, which it reorders in place, such that
+            all scans over the points access contiguous memory (DiameterEstimator::estimateDiameter3D).
+            The copy is filled directly from the coordinates of points with direct memory access
+            and from the coordinate arrays of a SoAPointsView, in PREC (float points are not converted
+            to double). Other expressions are evaluated into `evaluated` first.
+            The result is identical to the estimation on a pointer list into the points.
+            @param diamEstimator is the estimator which gets reseeded with `seed` (reused over calls)
+            @param evaluated is the scratch buffer for the evaluated points (reused over calls) */
         template<unsigned int Dimension, typename Derived>
         auto estimateDiameter(const MatrixBase<Derived>& points,
                               const PREC epsilon,
+                              DiameterEstimator& diamEstimator,
+                              MyMatrix::MatrixStatDyn<PREC, Dimension>& evaluated,
                               std::size_t seed = RandomGenerators::defaultSeed)
             -> std::pair<VectorStat<Dimension>, VectorStat<Dimension>>
         {
             ApproxMVBB_STATIC_ASSERTM(Derived::RowsAtCompileTime == Dimension,
                                       "input points matrix need to be (Dimension x N) ");
+            ApproxMVBB_STATIC_ASSERTM(Dimension == 2 || Dimension == 3, "estimate diameter only in 2d and 3d");
             ApproxMVBB_STATIC_ASSERTM((std::is_same<typename Derived::Scalar, PREC>::value),
-                                      "estimate diameter can only accept double so far");
+                                      "estimate diameter can only accept PREC points");
 
-            // Construct pointer list
-            auto size          = points.cols();
-            PREC const** pList = new PREC const*[size];
-            for(decltype(size) i = 0; i < size; ++i)
-            {
-                pList[i] = points.col(i).data();
-            }
+            using DirectAccess = std::integral_constant<bool, (Derived::Flags & Eigen::DirectAccessBit) != 0>;
+            const PREC* coordinates[Dimension];
+            unsigned int stride = details::diameterCoordinates(points, coordinates, evaluated, DirectAccess{});
 
-            Diameter::TypeSegment pairP;
-            DiameterEstimator diamEstimator(seed);
-            diamEstimator.estimateDiameter(&pairP, pList, 0, static_cast<int>(size - 1), Dimension, epsilon);
+            unsigned int index1 = 0, index2 = 0;
+            diamEstimator.seed(seed);
+            details::estimateDiameter(
+                diamEstimator, &index1, &index2, coordinates, static_cast<unsigned int>(points.cols()), stride, epsilon);
 
-            using Vector2d = MyMatrix::VectorStat<double, Dimension>;
-            const MatrixMap<const Vector2d> p1(pairP.extremity1);
-            const MatrixMap<const Vector2d> p2(pairP.extremity2);
+            return {points.col(index1), points.col(index2)};
+        }
 
-            ApproxMVBB_MSGLOG_L2("p1: " << p1.transpose() << std::endl
-                                        << "p2: " << p2.transpose() << std::endl
-                                        << " l: " << std::sqrt(pairP.squareDiameter) << std::endl);
+        /** Estimate the diameter of the point cloud `points` (see above) */
+        template<unsigned int Dimension, typename Derived>
+        auto estimateDiameter(const MatrixBase<Derived>& points,
+                              const PREC epsilon,
+                              DiameterEstimator& diamEstimator,
+                              std::size_t seed = RandomGenerators::defaultSeed)
+            -> std::pair<VectorStat<Dimension>, VectorStat<Dimension>>
+        {
+            MyMatrix::MatrixStatDyn<PREC, Dimension> evaluated;
+            return estimateDiameter<Dimension>(points, epsilon, diamEstimator, evaluated, seed);
+        }
 
-            delete[] pList;
-            return {p1, p2};
+        template<unsigned int Dimension, typename Derived>
+        auto estimateDiameter(const MatrixBase<Derived>& points,
+                              const PREC epsilon,
+                              std::size_t seed = RandomGenerators::defaultSeed)
+            -> std::pair<VectorStat<Dimension>, VectorStat<Dimension>>
+        {
+            DiameterEstimator diamEstimator(seed);
+            return estimateDiameter<Dimension>(points, epsilon, diamEstimator, seed);
         }
 
         class CompareByAngle
@@ -18,6 +18,7 @@
 #include "ApproxMVBB/PointFunctions.hpp"
 #include ApproxMVBB_OOBB_INCLUDE_FILE
 #include "ApproxMVBB/MinAreaRectangle.hpp"
+#include "ApproxMVBB/SoAPointsView.hpp"
 
 //#include "TestFunctions.hpp"
 
@@ -46,7 +47,7 @@ namespace ApproxMVBB
             // std::cout <<"projected points" <<std::endl;
 
             // Estimate diameter in 2d projective plane
-            std::pair<Vector2, Vector2> pp = estimateDiameter<2>(m_p, epsilon);
+            std::pair<Vector2, Vector2> pp = estimateDiameter<2>(m_p.leftCols(m_nPoints), epsilon, m_diamEstimator);
 
             Vector2 dirX = pp.first - pp.second;
             if((pp.second.array() >= pp.first.array()).all())
@@ -73,7 +74,7 @@ namespace ApproxMVBB
 
             AABB2d aabb;
             Vector2 p;
-            auto size = m_p.cols();
+            auto size = m_nPoints;
             for(unsigned int i = 0; i < size; ++i)
             {
                 p.noalias() = A2_MK * m_p.col(i);  // Transform all points
@@ -119,98 +120,222 @@ namespace ApproxMVBB
             m_zDir = zDir;
             project(points);
 
-            // compute minimum area rectangle first
-            // std::cout << "Dump points DEBUG:" << std::endl;
-            // TestFunctions::dumpPointsMatrixBinary("DumpedPoints.bin",m_p);
+            return computeMVBBOfProjection();
+        }
 
-            MinAreaRectangle mar(m_p);
-            mar.compute();
-            auto rect = mar.getMinRectangle();
+        /** Computes the same MVBB as computeMVBB, but projects the points in chunks of
+     * `chunkSize` points and after each chunk discards all points which can not be
+     * on the convex hull (Akl-Toussaint heuristic: points strictly inside the octagon
+     * of the extreme points in 8 directions).
+     * The octagon keeps a fixed fraction of the points of curved clouds, therefore the candidates are
+     * reduced to the vertices of their 2d convex hull as soon as there are more than twice the
+     * vertices of the last reduction plus the chunk. This needs O(hull + chunkSize) memory instead
+     * of O(N) and the convex hull is only computed on the remaining candidate points.
+     */
+        template<typename Derived>
+        OOBB computeMVBBStreaming(const Vector3& zDir,
+                                  const MatrixBase<Derived>& points,
+                                  typename Derived::Index chunkSize = 1 << 16)
+        {
+            EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
 
-            // std::cout << "Dump RECT DEBUG:" << std::endl;
-            // Vector2List p;
-            // p.push_back( rect.m_p);
-            // p.push_back( rect.m_p + rect.m_u );
-            // p.push_back( rect.m_p + rect.m_u + rect.m_v );
-            // p.push_back( rect.m_p + rect.m_v );
-            // p.push_back( rect.m_p);
+            if(points.cols() == 0)
+            {
+                ApproxMVBB_ERRORMSG("Point set empty!");
+            }
+            if(chunkSize <= 0)
+            {
+                ApproxMVBB_ERRORMSG("Chunk size needs to be positive: " << chunkSize);
+            }
 
-            // TestFunctions::dumpPoints("./MinAreaRectangleTest13" "Out.txt",p);
+            beginMVBBStreaming(zDir);
 
-            // Box coordinates are in K Frame
+            auto size = points.cols();
+            for(decltype(size) first = 0; first < size; first += chunkSize)
+            {
+                addMVBBStreaming(points.middleCols(first, std::min(chunkSize, size - first)));
+            }
 
-            Matrix22 A2_KM;
+            return endMVBBStreaming();
+        }
 
-            //        std::cout << "u:" << rect.m_u.norm() << std::endl;
-            //        std::cout << "v:" << rect.m_v.norm() << std::endl;
+        /** Incremental form of computeMVBBStreaming for point clouds which are only available
+     * block by block (e.g. read from disk): beginMVBBStreaming, addMVBBStreaming for each block
+     * and endMVBBStreaming, which returns the MVBB in direction `zDir` of all added points.
+     */
+        void beginMVBBStreaming(const Vector3& zDir)
+        {
+            m_zDir = zDir;
+            setupProjection();
 
-            A2_KM.col(0) = rect.m_u;
-            A2_KM.col(1) = rect.m_v;
+            m_maxZValue = std::numeric_limits<PREC>::lowest();
+            m_minZValue = std::numeric_limits<PREC>::max();
+            m_nPoints   = 0;
+            m_hullSize  = 0;
+        }
 
-            Vector2 M_p = A2_KM.transpose() * rect.m_p;
+        template<typename Derived>
+        void addMVBBStreaming(const MatrixBase<Derived>& points)
+        {
+            EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Derived, 3, Eigen::Dynamic);
 
-            Vector3 M_min;
-            M_min.head<2>() = M_p;
-            M_min(2)        = m_minZValue;
+            auto n = points.cols();
+            if(n == 0)
+            {
+                return;
+            }
 
-            Vector3 M_max(rect.m_uL, rect.m_vL, 0.0);
-            M_max.head<2>() += M_p;
-            M_max(2) = m_maxZValue;
+            // Append projected points to the candidate points
+            if(m_p.cols() < m_nPoints + n)
+            {
+                m_p.conservativeResize(2, m_nPoints + n);
+            }
+            projectPoints(points, m_nPoints);
 
-            // Make coordinate transformation from `M` coordinate system (Minimum Rectancle)
-            // to `K` coordinate system (Projection Plane);
-            Matrix33 A_IM;
-            // Make A_KM
-            A_IM.setIdentity();
-            A_IM.block<2, 2>(0, 0) = A2_KM;
-            // Make A_IM;
-            A_IM = m_A_KI.transpose() * A_IM;  // A_IM = A_IK * A_KM
-
-            return OOBB(M_min, M_max, A_IM);
+            m_nPoints = discardInteriorPoints(m_nPoints + n);
+            if(m_nPoints > 2 * m_hullSize + n)
+            {
+                m_nPoints  = reduceToConvexHull(m_nPoints);
+                m_hullSize = m_nPoints;
+            }
+        }
+
+        OOBB endMVBBStreaming()
+        {
+            if(m_nPoints == 0)
+            {
+                ApproxMVBB_ERRORMSG("Point set empty!");
+            }
+            return computeMVBBOfProjection();
+        }
+
+        /** Number of candidate points kept by the streaming computation (see addMVBBStreaming) */
+        Matrix2Dyn::Index getNumberOfCandidates() const
+        {
+            return m_nPoints;
         }
 
     private:
         template<typename Derived>
         void project(const MatrixBase<Derived>& points)
         {
-            using namespace CoordinateSystem;
-
             if(points.cols() == 0)
             {
                 ApproxMVBB_ERRORMSG("Point set empty!");
             }
 
-            // Generate Orthonormal Bases
-            Vector3 xDir, yDir;
-            // std::cout << "dir: " <<  m_zDir << std::endl;
-            makeCoordinateSystem(m_zDir, xDir, yDir);
-
-            // Make coodinate transform from coordinate system `I`  to K!
-            m_A_KI.col(0) = xDir;
-            m_A_KI.col(1) = yDir;
-            m_A_KI.col(2) = m_zDir;
-            m_A_KI.transposeInPlace();
-            ApproxMVBB_ASSERTMSG(
-                checkOrthogonality(xDir, yDir, m_zDir, 1e-6),
-                "Not orthogonal: x:" << xDir.transpose() << " y: " << yDir.transpose() << " z: " << m_zDir.transpose());
+            setupProjection();
 
             // Project Points onto xDir,yDir Halfspace
+            // (the buffer m_p only grows, such that repeated projections do not allocate)
             auto size = points.cols();
-            m_p.resize(2, size);
+            if(m_p.cols() < size)
+            {
+                m_p.resize(2, size);
+            }
+            m_nPoints = size;
             // m_p = m_A_KI * points;  // Project points! (below is faster)
-            Vector3 p;
             m_maxZValue = std::numeric_limits<PREC>::lowest();
             m_minZValue = std::numeric_limits<PREC>::max();
-            for(decltype(size) i = 0; i < size; ++i)
+            projectPoints(points, 0);
+        }
+
+        /** Projects `points` into m_p starting at column `dest` and extends the z-range [m_minZValue,m_maxZValue].
+         * The transformation, the store of the 2d points and the z-range are fused in one pass over the points.
+         * Two points are processed per iteration with independent min/max accumulators, which
+         * breaks the dependency chain of the reduction and lets the fixed size products vectorize.
+         */
+        template<typename Derived>
+        void projectPoints(const MatrixBase<Derived>& points, Matrix2Dyn::Index dest)
+        {
+            const Matrix23 A2 = m_A_KI.topRows<2>();
+            const Vector3 a3  = m_A_KI.row(2).transpose();
+
+            PREC minZ[2] = {m_minZValue, m_minZValue};
+            PREC maxZ[2] = {m_maxZValue, m_maxZValue};
+
+            auto size = points.cols();
+            decltype(size) i = 0;
+            for(; i + 1 < size; i += 2)
             {
-                p           = m_A_KI * points.col(i);
-                m_p.col(i)  = p.head<2>();
-                m_maxZValue = std::max(m_maxZValue, p(2));
-                m_minZValue = std::min(m_minZValue, p(2));
+                m_p.col(dest + i).noalias()     = A2 * points.col(i);
+                m_p.col(dest + i + 1).noalias() = A2 * points.col(i + 1);
+                PREC z0                         = a3.dot(points.col(i));
+                PREC z1                         = a3.dot(points.col(i + 1));
+                minZ[0]                         = std::min(minZ[0], z0);
+                maxZ[0]                         = std::max(maxZ[0], z0);
+                minZ[1]                         = std::min(minZ[1], z1);
+                maxZ[1]                         = std::max(maxZ[1], z1);
+            }
+            if(i < size)
+            {
+                m_p.col(dest + i).noalias() = A2 * points.col(i);
+                PREC z0                     = a3.dot(points.col(i));
+                minZ[0]                     = std::min(minZ[0], z0);
+                maxZ[0]                     = std::max(maxZ[0], z0);
+            }
+
+            m_minZValue = std::min(minZ[0], minZ[1]);
+            m_maxZValue = std::max(maxZ[0], maxZ[1]);
+        }
+
+        /** Projects the points of a structure of arrays view (see projectPoints above).
+         * The coordinate arrays are processed in blocks with array expressions over x, y, z,
+         * which vectorize over the points.
+         */
+        void projectPoints(const MatrixBase<SoAPointsView>& points, Matrix2Dyn::Index dest)
+        {
+            using ArrayMap = MatrixMap<const Eigen::Array<PREC, Eigen::Dynamic, 1>>;
+            const details::SoAPointsFunctor& f = points.derived().functor();
+            auto size                          = points.cols();
+            const ArrayMap x(f.coordinates(0), size);
+            const ArrayMap y(f.coordinates(1), size);
+            const ArrayMap z(f.coordinates(2), size);
+
+            const Matrix33& A = m_A_KI;
+            static const Matrix2Dyn::Index blockSize = 256;
+            for(decltype(size) i = 0; i < size; i += blockSize)
+            {
+                auto n  = std::min(blockSize, size - i);
+                auto xb = x.segment(i, n);
+                auto yb = y.segment(i, n);
+                auto zb = z.segment(i, n);
+
+                m_p.row(0).segment(dest + i, n) = (A(0, 0) * xb + A(0, 1) * yb + A(0, 2) * zb).matrix().transpose();
+                m_p.row(1).segment(dest + i, n) = (A(1, 0) * xb + A(1, 1) * yb + A(1, 2) * zb).matrix().transpose();
+
+                auto zK     = A(2, 0) * xb + A(2, 1) * yb + A(2, 2) * zb;
+                m_minZValue = std::min(m_minZValue, zK.minCoeff());
+                m_maxZValue = std::max(m_maxZValue, zK.maxCoeff());
             }
         }
 
-        Matrix2Dyn m_p;  ///< Projected points in coordinate system `K` 
+        /** Make the transformation m_A_KI into the projection coordinate system `K` with z-axis m_zDir */
+        void setupProjection();
+
+        /** Computes the MVBB of the projected points m_p (see computeMVBB) */
+        OOBB computeMVBBOfProjection();
+
+        /** Removes all points from the first `nPoints` points in m_p which are strictly inside the
+     * octagon spanned by the extreme points in the directions (±1,0), (0,±1), (±1,±1).
+     * These points are not on the convex hull. Returns the number of remaining points.
+     */
+        Matrix2Dyn::Index discardInteriorPoints(Matrix2Dyn::Index nPoints);
+
+        /** Keeps only the vertices of the convex hull of the first `nPoints` points in m_p
+     * (monotone chain). Returns the number of remaining points.
+     */
+        Matrix2Dyn::Index reduceToConvexHull(Matrix2Dyn::Index nPoints);
+
+        /** Number of projected points from which on the convex hull is computed in parallel */
+        static const Matrix2Dyn::Index m_parallelHullMinPoints = 1 << 20;
+
+        Matrix2Dyn m_p;  ///< Projected points in coordinate system `K` (only the first m_nPoints columns are valid)
+        Matrix2Dyn::Index m_nPoints  = 0;  ///< Number of projected points.
+        Matrix2Dyn::Index m_hullSize = 0;  ///< Number of hull vertices after the last reduceToConvexHull.
+
+        MinAreaRectangle::Buffers m_rectBuffers;         ///< Buffers for the minimum area rectangle.
+        DiameterEstimator m_diamEstimator;               ///< Estimator for the 2d diameter.
 
         Vector3 m_zDir;
         Matrix33 m_A_KI;  ///< Transformation from coordinate system `I`  into the projection coordinate system `K` 
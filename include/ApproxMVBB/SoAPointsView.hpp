@@ -0,0 +1,67 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz
+//  (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#ifndef ApproxMVBB_SoAPointsView_hpp
+#define ApproxMVBB_SoAPointsView_hpp
+
+#include "ApproxMVBB/Config/Config.hpp"
+#include ApproxMVBB_TypeDefs_INCLUDE_FILE
+#include "ApproxMVBB/Common/TypeDefsPoints.hpp"
+
+namespace ApproxMVBB
+{
+    ApproxMVBB_DEFINE_MATRIX_TYPES;
+    ApproxMVBB_DEFINE_POINTS_CONFIG_TYPES;
+
+    namespace details
+    {
+        /** Coefficient access (row = coordinate, col = point) into three coordinate arrays */
+        class SoAPointsFunctor
+        {
+        public:
+            using Index = Matrix3Dyn::Index;
+
+            SoAPointsFunctor(const PREC* x, const PREC* y, const PREC* z)
+                : m_coords{x, y, z}
+            {
+            }
+
+            inline const PREC& operator()(Index row, Index col) const
+            {
+                return m_coords[row][col];
+            }
+
+            /** Coordinate array of coordinate `i` (0,1,2) */
+            inline const PREC* coordinates(unsigned int i) const
+            {
+                return m_coords[i];
+            }
+
+        private:
+            const PREC* m_coords[3];
+        };
+    }  // namespace details
+
+    /** Read-only view of points stored as structure of arrays (three contiguous arrays x, y, z)
+     * as a `3 x N` Eigen expression. The view can be passed to all algorithms in
+     * ComputeApproxMVBB.hpp instead of a Matrix3Dyn without copying the points.
+     * ProjectedPointSet projects whole views directly from the three arrays.
+     * The diameter estimation reads the three arrays in place as well.
+     */
+    using SoAPointsView = Eigen::CwiseNullaryOp<details::SoAPointsFunctor, Matrix3Dyn>;
+
+    /** Make a view of the `n` points (x[i],y[i],z[i]) */
+    inline SoAPointsView makeSoAPointsView(const PREC* x, const PREC* y, const PREC* z, Matrix3Dyn::Index n)
+    {
+        return Matrix3Dyn::NullaryExpr(3, n, details::SoAPointsFunctor(x, y, z));
+    }
+}  // namespace ApproxMVBB
+
+#endif
@@ -10,7 +10,16 @@
 //#include <iterator> // for ostream_iterator
 //#include "TestFunctions.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
 #include "ApproxMVBB/ConvexHull2D.hpp"
+
+#if defined(ApproxMVBB_OPENMP_SUPPORT) && defined(_OPENMP)
+#    include <omp.h>
+#endif
+
 namespace ApproxMVBB
 {
     void ConvexHull2D::compute()
@@ -33,8 +42,8 @@ namespace ApproxMVBB
 
         // Indices into m_p
         // first = index into m_p, second =  delete flag!
-        using PointData = std::pair<unsigned int, bool>;
-        std::vector<PointData> indices;
+        auto& indices = m_buffers.m_indices;
+        indices.clear();
         indices.reserve(m_p.cols());
 
         // Save p0 as first point in indices list (temporary)
@@ -63,7 +72,8 @@ namespace ApproxMVBB
         CompareByAngle comp(m_p, base, position, deletedPoints);
         std::sort(indices.begin() + 1, indices.end(), comp);
 
-        std::vector<unsigned int> indicesT(indices.size() - deletedPoints);
+        auto& indicesT = m_buffers.m_indicesT;
+        indicesT.resize(indices.size() - deletedPoints);
         unsigned int k = 0;
         for(auto& p : indices)
         {
@@ -181,6 +191,315 @@ namespace ApproxMVBB
         }
     }
 
+    template<typename Iterator>
+    void ConvexHull2D::chainHull(Iterator begin, Iterator end, std::vector<unsigned int>& hull) const
+    {
+        using namespace PointFunctions;
+
+        if(begin == end)
+        {
+            return;
+        }
+
+        // Equal points are consecutive, only the first one is used (the smallest index)
+        auto isDuplicate = [&](Iterator it) { return it != begin && equal(m_p.col(*it), m_p.col(*std::prev(it))); };
+
+        // Lower hull from left to right, then upper hull from right to left,
+        // only keeping strict left turns
+        hull.reserve(hull.size() + (end - begin) + 1);
+        for(auto it = begin; it != end; ++it)
+        {
+            if(isDuplicate(it))
+            {
+                continue;
+            }
+            while(hull.size() >= 2 && !leftTurn(m_p.col(hull[hull.size() - 2]), m_p.col(hull.back()), m_p.col(*it)))
+            {
+                hull.pop_back();
+            }
+            hull.push_back(*it);
+        }
+
+        // Start the upper hull after the last point of the lower hull
+        auto lowerSize = hull.size() + 1;
+        auto rbegin    = std::make_reverse_iterator(end);
+        while(isDuplicate(std::prev(rbegin.base())))
+        {
+            ++rbegin;
+        }
+        for(auto it = rbegin + 1; it != std::make_reverse_iterator(begin); ++it)
+        {
+            if(isDuplicate(std::prev(it.base())))
+            {
+                continue;
+            }
+            while(hull.size() >= lowerSize &&
+                  !leftTurn(m_p.col(hull[hull.size() - 2]), m_p.col(hull.back()), m_p.col(*it)))
+            {
+                hull.pop_back();
+            }
+            hull.push_back(*it);
+        }
+
+        // The first point is also the last one
+        if(hull.size() > 1)
+        {
+            hull.pop_back();
+        }
+    }
+
+    void ConvexHull2D::compute(Algorithm algorithm)
+    {
+        switch(algorithm)
+        {
+            case Algorithm::GrahamScan: compute(); break;
+            case Algorithm::MonotoneChain: computeMonotonChain(); break;
+            case Algorithm::QuickHull: computeQuickHull(); break;
+            case Algorithm::ParallelMonotoneChain: computeParallel(); break;
+        }
+    }
+
+    void ConvexHull2D::computeMonotonChain()
+    {
+        m_indicesCH.clear();
+
+        auto nPoints = static_cast<unsigned int>(m_p.cols());
+        if(nPoints == 0)
+        {
+            return;
+        }
+
+        // Sort all points by x (then y)
+        auto& sorted = m_buffers.m_indicesT;
+        sorted.resize(nPoints);
+        for(unsigned int i = 0; i < nPoints; ++i)
+        {
+            sorted[i] = i;
+        }
+        std::sort(sorted.begin(), sorted.end(), [this](unsigned int a, unsigned int b) { return lessXY(a, b); });
+
+        chainHull(sorted.begin(), sorted.end(), m_indicesCH);
+        finalizeHull();
+    }
+
+    void ConvexHull2D::computeParallel(unsigned int nBlocks)
+    {
+        m_indicesCH.clear();
+
+        auto nPoints = static_cast<unsigned int>(m_p.cols());
+        if(nPoints == 0)
+        {
+            return;
+        }
+
+        if(nBlocks == 0)
+        {
+#if defined(ApproxMVBB_OPENMP_SUPPORT) && defined(ApproxMVBB_OPENMP_USE_NTHREADS)
+            nBlocks = ApproxMVBB_OPENMP_NTHREADS;
+#elif defined(ApproxMVBB_OPENMP_SUPPORT) && defined(_OPENMP)
+            nBlocks = static_cast<unsigned int>(omp_get_max_threads());
+#else
+            nBlocks = 1;
+#endif
+            // Each block should have some points
+            nBlocks = std::min(nBlocks, nPoints / 1024);
+        }
+        nBlocks = std::max(std::min(nBlocks, nPoints), 1U);
+
+        auto& sorted = m_buffers.m_indicesT;
+        sorted.resize(nPoints);
+        for(unsigned int i = 0; i < nPoints; ++i)
+        {
+            sorted[i] = i;
+        }
+
+        // Convex hull of each block: every vertex of the convex hull is also a vertex of the convex hull
+        // of its block. Equal points are ordered by index, such that the monotone chain keeps the same
+        // point of equal points in the blocks and in the full point set.
+        auto& blockHulls = m_buffers.m_blockHulls;
+        blockHulls.resize(nBlocks);
+        int n = static_cast<int>(nBlocks);
+
+        // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+        #pragma omp parallel for schedule(static, 1) ApproxMVBB_OPENMP_NUMTHREADS
+#endif
+        // clang-format on
+        for(int b = 0; b < n; ++b)
+        {
+            auto begin = sorted.begin() + static_cast<std::size_t>(nPoints) * b / nBlocks;
+            auto end   = sorted.begin() + static_cast<std::size_t>(nPoints) * (b + 1) / nBlocks;
+            std::sort(begin, end, [this](unsigned int i, unsigned int j) { return lessXY(i, j); });
+            blockHulls[b].clear();
+            chainHull(begin, end, blockHulls[b]);
+        }
+
+        // Merge: monotone chain over the hull vertices of all blocks
+        auto& candidates = m_buffers.m_candidates;
+        candidates.clear();
+        for(auto& h : blockHulls)
+        {
+            candidates.insert(candidates.end(), h.begin(), h.end());
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](unsigned int a, unsigned int b) { return lessXY(a, b); });
+
+        chainHull(candidates.begin(), candidates.end(), m_indicesCH);
+        finalizeHull();
+    }
+
+    void ConvexHull2D::computeQuickHull()
+    {
+        using namespace PointFunctions;
+
+        m_indicesCH.clear();
+
+        auto nPoints = static_cast<unsigned int>(m_p.cols());
+        if(nPoints == 0)
+        {
+            return;
+        }
+
+        // Extreme points a (min x, min y) and b (max x, max y)
+        unsigned int a = 0, b = 0;
+        for(unsigned int i = 1; i < nPoints; ++i)
+        {
+            if(lessXY(i, a))
+            {
+                a = i;
+            }
+            if(lessXY(b, i))
+            {
+                b = i;
+            }
+        }
+
+        auto& candidates = m_buffers.m_candidates;
+        candidates.clear();
+        candidates.push_back(a);
+
+        if(equal(m_p.col(a), m_p.col(b)))
+        {
+            m_indicesCH.push_back(a);
+            return;
+        }
+        candidates.push_back(b);
+
+        // Points strictly right of a->b (lower hull) followed by the points strictly right of b->a (upper hull)
+        auto& work = m_buffers.m_indicesT;
+        work.clear();
+        for(unsigned int i = 0; i < nPoints; ++i)
+        {
+            if(orient2d(m_p.col(a), m_p.col(b), m_p.col(i)) < 0)
+            {
+                work.push_back(i);
+            }
+        }
+        auto nLower = work.size();
+        for(unsigned int i = 0; i < nPoints; ++i)
+        {
+            if(orient2d(m_p.col(b), m_p.col(a), m_p.col(i)) < 0)
+            {
+                work.push_back(i);
+            }
+        }
+
+        // Recursion (with an explicit stack) over the segments (p,q) with the range of points
+        // strictly right of p->q. The farthest point c from p->q is a hull candidate and all points
+        // inside the triangle p,c,q are discarded.
+        // (c is only the farthest in floating point, the hull is therefore computed with a monotone
+        // chain over all candidates, which are a superset of the hull points)
+        struct Segment
+        {
+            unsigned int p, q;
+            std::size_t begin, end;
+        };
+        std::vector<Segment> stack;
+        stack.push_back({a, b, 0, nLower});
+        stack.push_back({b, a, nLower, work.size()});
+
+        while(!stack.empty())
+        {
+            Segment s = stack.back();
+            stack.pop_back();
+            if(s.begin == s.end)
+            {
+                continue;
+            }
+
+            // Farthest point from p->q (most negative cross product)
+            const Vector2 p  = m_p.col(s.p);
+            const Vector2 pq = m_p.col(s.q) - p;
+            unsigned int c   = work[s.begin];
+            PREC cMin        = std::numeric_limits<PREC>::max();
+            for(std::size_t i = s.begin; i < s.end; ++i)
+            {
+                Vector2 pr = m_p.col(work[i]) - p;
+                PREC d     = pq(0) * pr(1) - pq(1) * pr(0);
+                if(d < cMin)
+                {
+                    cMin = d;
+                    c    = work[i];
+                }
+            }
+            candidates.push_back(c);
+
+            // Partition: [ right of p->c | right of c->q | discarded ]
+            std::size_t m1 = s.begin;
+            for(std::size_t i = s.begin; i < s.end; ++i)
+            {
+                if(orient2d(m_p.col(s.p), m_p.col(c), m_p.col(work[i])) < 0)
+                {
+                    std::swap(work[i], work[m1++]);
+                }
+            }
+            std::size_t m2 = m1;
+            for(std::size_t i = m1; i < s.end; ++i)
+            {
+                if(orient2d(m_p.col(c), m_p.col(s.q), m_p.col(work[i])) < 0)
+                {
+                    std::swap(work[i], work[m2++]);
+                }
+            }
+
+            stack.push_back({s.p, c, s.begin, m1});
+            stack.push_back({c, s.q, m1, m2});
+        }
+
+        // Monotone chain over all candidates
+        std::sort(candidates.begin(), candidates.end(), [this](unsigned int a, unsigned int b) { return lessXY(a, b); });
+        chainHull(candidates.begin(), candidates.end(), m_indicesCH);
+        finalizeHull();
+    }
+
+    void ConvexHull2D::finalizeHull()
+    {
+        using namespace PointFunctions;
+
+        // Remove almost equal consecutive points
+        if(m_indicesCH.size() > 1)
+        {
+            unsigned int k = 1;
+            for(unsigned int i = 1; i < m_indicesCH.size(); ++i)
+            {
+                if(!almostEqualUlp(m_p.col(m_indicesCH[i]), m_p.col(m_indicesCH[k - 1])))
+                {
+                    m_indicesCH[k++] = m_indicesCH[i];
+                }
+            }
+            m_indicesCH.resize(k);
+            while(m_indicesCH.size() > 1 && almostEqualUlp(m_p.col(m_indicesCH.back()), m_p.col(m_indicesCH.front())))
+            {
+                m_indicesCH.pop_back();
+            }
+        }
+
+        // Start at the lowest (leftmost) point
+        auto it = std::min_element(m_indicesCH.begin(), m_indicesCH.end(), [this](unsigned int a, unsigned int b) {
+            return m_p(1, a) < m_p(1, b) || (m_p(1, a) == m_p(1, b) && m_p(0, a) < m_p(0, b));
+        });
+        std::rotate(m_indicesCH.begin(), it, m_indicesCH.end());
+    }
+
     bool ConvexHull2D::verifyHull()
     {
         using namespace PointFunctions;
@@ -0,0 +1,391 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz
+//  (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "ApproxMVBB/ConvexHull3D.hpp"
+#include "ApproxMVBB/ConvexHull2D.hpp"
+
+namespace ApproxMVBB
+{
+    void ConvexHull3D::compute()
+    {
+        m_vertices.clear();
+        m_faces.clear();
+        m_hullFaces.clear();
+
+        unsigned int n = static_cast<unsigned int>(m_p.cols());
+        if(n == 0)
+        {
+            return;
+        }
+
+        // Tolerance relative to the magnitude of the coordinates
+        m_tolerance = 3 * std::numeric_limits<PREC>::epsilon() * m_p.cwiseAbs().rowwise().maxCoeff().sum();
+
+        // Extreme points along the axes, the two of the largest extent span the first edge
+        std::array<unsigned int, 3> minIdx{{0, 0, 0}}, maxIdx{{0, 0, 0}};
+        for(unsigned int i = 1; i < n; ++i)
+        {
+            for(unsigned int k = 0; k < 3; ++k)
+            {
+                if(m_p(k, i) < m_p(k, minIdx[k]))
+                {
+                    minIdx[k] = i;
+                }
+                if(m_p(k, i) > m_p(k, maxIdx[k]))
+                {
+                    maxIdx[k] = i;
+                }
+            }
+        }
+        unsigned int axis = 0;
+        for(unsigned int k = 1; k < 3; ++k)
+        {
+            if(m_p(k, maxIdx[k]) - m_p(k, minIdx[k]) > m_p(axis, maxIdx[axis]) - m_p(axis, minIdx[axis]))
+            {
+                axis = k;
+            }
+        }
+        unsigned int i0 = minIdx[axis], i1 = maxIdx[axis];
+        if(m_p(axis, i1) - m_p(axis, i0) <= m_tolerance)
+        {
+            // All points are equal
+            m_vertices.push_back(i0);
+            return;
+        }
+
+        // Thinner point sets are treated as collinear (coplanar): the normals of faces with a
+        // height `h` over an edge of length `extent` have round-off errors of about
+        // `epsilon * extent / h`, which lets the hull miss points by `epsilon * extent^2 / h`.
+        // The degenerate hulls miss points by at most `h`, both are balanced at this threshold.
+        const PREC flatTolerance =
+            std::max(m_tolerance, std::sqrt(std::numeric_limits<PREC>::epsilon()) * (m_p(axis, i1) - m_p(axis, i0)));
+
+        // Farthest point from the line
+        Vector3 u       = (m_p.col(i1) - m_p.col(i0)).normalized();
+        unsigned int i2 = i0;
+        PREC maxDist    = 0;
+        for(unsigned int i = 0; i < n; ++i)
+        {
+            PREC d = (m_p.col(i) - m_p.col(i0)).cross(u).norm();
+            if(d > maxDist)
+            {
+                maxDist = d;
+                i2      = i;
+            }
+        }
+        if(maxDist <= flatTolerance)
+        {
+            computeDegenerate(i0, i1, i2, true);
+            return;
+        }
+
+        // Farthest point from the plane
+        Vector3 normal  = u.cross(m_p.col(i2) - m_p.col(i0)).normalized();
+        unsigned int i3 = i0;
+        maxDist         = 0;
+        for(unsigned int i = 0; i < n; ++i)
+        {
+            PREC d = std::abs(normal.dot(m_p.col(i) - m_p.col(i0)));
+            if(d > maxDist)
+            {
+                maxDist = d;
+                i3      = i;
+            }
+        }
+        if(maxDist <= flatTolerance)
+        {
+            computeDegenerate(i0, i1, i2, false);
+            return;
+        }
+
+        // Initial tetrahedron with outward normals
+        if(normal.dot(m_p.col(i3) - m_p.col(i0)) > 0)
+        {
+            std::swap(i1, i2);
+        }
+        addFace(i0, i1, i2);
+        addFace(i0, i3, i1);
+        addFace(i1, i3, i2);
+        addFace(i2, i3, i0);
+        for(int f = 0; f < 4; ++f)
+        {
+            for(int i = 0; i < 3; ++i)
+            {
+                for(int g = 0; g < 4; ++g)
+                {
+                    for(int j = 0; g != f && j < 3; ++j)
+                    {
+                        if(m_hullFaces[g].m_v[j] == m_hullFaces[f].m_v[(i + 1) % 3] &&
+                           m_hullFaces[g].m_v[(j + 1) % 3] == m_hullFaces[f].m_v[i])
+                        {
+                            m_hullFaces[f].m_neighbors[i] = g;
+                        }
+                    }
+                }
+            }
+        }
+
+        m_nextOutside.assign(n, -1);
+        for(unsigned int i = 0; i < n; ++i)
+        {
+            if(i != i0 && i != i1 && i != i2 && i != i3)
+            {
+                assignOutside(i, 0, 4);
+            }
+        }
+
+        // Add the farthest outside point of each face, the new faces are appended
+        for(std::size_t f = 0; f < m_hullFaces.size(); ++f)
+        {
+            if(m_hullFaces[f].m_deleted || m_hullFaces[f].m_outside < 0)
+            {
+                continue;
+            }
+
+            unsigned int eye = 0;
+            maxDist          = std::numeric_limits<PREC>::lowest();
+            for(int i = m_hullFaces[f].m_outside; i >= 0; i = m_nextOutside[i])
+            {
+                PREC d = distance(m_hullFaces[f], i);
+                if(d > maxDist)
+                {
+                    maxDist = d;
+                    eye     = i;
+                }
+            }
+
+            if(!computeHorizon(eye, static_cast<int>(f)))
+            {
+                // Round-off broke the hull, all points span it
+                m_hullFaces.clear();
+                m_vertices.resize(n);
+                std::iota(m_vertices.begin(), m_vertices.end(), 0u);
+                return;
+            }
+
+            // Cone of new faces from the horizon to the eye point
+            int first = static_cast<int>(m_hullFaces.size());
+            int nNew  = static_cast<int>(m_horizon.size());
+            for(int k = 0; k < nNew; ++k)
+            {
+                const HorizonEdge& h                        = m_horizon[k];
+                int newFace                                 = addFace(h.m_a, h.m_b, eye);
+                m_hullFaces[h.m_face].m_neighbors[h.m_edge] = newFace;
+
+                // The next/previous new faces are the neighbors over the edges to the eye point
+                int next                         = first + (k + 1) % nNew;
+                int prev                         = first + (k + nNew - 1) % nNew;
+                m_hullFaces[newFace].m_neighbors = {{h.m_face, next, prev}};
+            }
+
+            // Reassign the outside points of the visible faces
+            for(int v : m_visible)
+            {
+                int next = -1;
+                for(int i = m_hullFaces[v].m_outside; i >= 0; i = next)
+                {
+                    next = m_nextOutside[i];
+                    if(static_cast<unsigned int>(i) != eye)
+                    {
+                        assignOutside(i, first, m_hullFaces.size());
+                    }
+                }
+                m_hullFaces[v].m_outside = -1;
+            }
+        }
+
+        for(auto& face : m_hullFaces)
+        {
+            if(!face.m_deleted)
+            {
+                m_faces.push_back(face.m_v);
+                m_vertices.insert(m_vertices.end(), face.m_v.begin(), face.m_v.end());
+            }
+        }
+        std::sort(m_vertices.begin(), m_vertices.end());
+        m_vertices.erase(std::unique(m_vertices.begin(), m_vertices.end()), m_vertices.end());
+    }
+
+    int ConvexHull3D::addFace(unsigned int a, unsigned int b, unsigned int c)
+    {
+        HullFace face;
+        face.m_v         = {{a, b, c}};
+        face.m_neighbors = {{-1, -1, -1}};
+        face.m_normal    = (m_p.col(b) - m_p.col(a)).cross(m_p.col(c) - m_p.col(a)).normalized();
+        face.m_offset    = face.m_normal.dot(m_p.col(a));
+        m_hullFaces.push_back(face);
+        return static_cast<int>(m_hullFaces.size()) - 1;
+    }
+
+    bool ConvexHull3D::assignOutside(unsigned int i, std::size_t first, std::size_t end)
+    {
+        int best      = -1;
+        PREC bestDist = m_tolerance;
+        for(std::size_t f = first; f < end; ++f)
+        {
+            PREC d = distance(m_hullFaces[f], i);
+            if(d > bestDist)
+            {
+                bestDist = d;
+                best     = static_cast<int>(f);
+            }
+        }
+        if(best < 0)
+        {
+            return false;
+        }
+        m_nextOutside[i]            = m_hullFaces[best].m_outside;
+        m_hullFaces[best].m_outside = static_cast<int>(i);
+        return true;
+    }
+
+    bool ConvexHull3D::computeHorizon(unsigned int eye, int face)
+    {
+        m_visible.clear();
+        m_horizon.clear();
+        m_horizonStack.clear();
+
+        // Depth-first walk over the visible faces, the first face continues over all edges,
+        // the others over the two edges after the one they were entered
+        m_hullFaces[face].m_deleted = true;
+        m_visible.push_back(face);
+        m_horizonStack.push_back(HorizonStep{face, 0, 3});
+        while(!m_horizonStack.empty())
+        {
+            HorizonStep& step = m_horizonStack.back();
+            if(step.m_count == 0)
+            {
+                m_horizonStack.pop_back();
+                continue;
+            }
+            int current = step.m_face;
+            int i       = step.m_edge;
+            step.m_edge = (i + 1) % 3;
+            --step.m_count;
+
+            unsigned int a = m_hullFaces[current].m_v[i];
+            unsigned int b = m_hullFaces[current].m_v[(i + 1) % 3];
+            int neighbor   = m_hullFaces[current].m_neighbors[i];
+            if(neighbor < 0)
+            {
+                return false;
+            }
+            if(m_hullFaces[neighbor].m_deleted)
+            {
+                continue;
+            }
+
+            // Edge `b -> a` in the neighbor
+            int j = 0;
+            while(j < 3 && !(m_hullFaces[neighbor].m_v[j] == b && m_hullFaces[neighbor].m_v[(j + 1) % 3] == a))
+            {
+                ++j;
+            }
+            if(j == 3)
+            {
+                return false;
+            }
+
+            if(distance(m_hullFaces[neighbor], eye) > m_tolerance)
+            {
+                m_hullFaces[neighbor].m_deleted = true;
+                m_visible.push_back(neighbor);
+                m_horizonStack.push_back(HorizonStep{neighbor, (j + 1) % 3, 2});
+            }
+            else
+            {
+                m_horizon.push_back(HorizonEdge{a, b, neighbor, j});
+            }
+        }
+
+        // The horizon must be a closed cycle, otherwise the visible faces are not a disk
+        std::size_t nEdges = m_horizon.size();
+        if(nEdges < 3)
+        {
+            return false;
+        }
+        for(std::size_t k = 0; k < nEdges; ++k)
+        {
+            if(m_horizon[k].m_b != m_horizon[(k + 1) % nEdges].m_a)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void ConvexHull3D::computeDegenerate(unsigned int i0, unsigned int i1, unsigned int i2, bool collinear)
+    {
+        if(collinear)
+        {
+            m_vertices = {std::min(i0, i1), std::max(i0, i1)};
+            return;
+        }
+
+        // Convex hull in the plane
+        Vector3 e1 = (m_p.col(i1) - m_p.col(i0)).normalized();
+        Vector3 e2 = e1.cross(m_p.col(i2) - m_p.col(i0)).cross(e1).normalized();
+        Matrix2Dyn q(2, m_p.cols());
+        q.row(0) = e1.transpose() * m_p;
+        q.row(1) = e2.transpose() * m_p;
+
+        ConvexHull2D hull(q);
+        hull.compute();
+        m_vertices = hull.getIndices();
+        std::sort(m_vertices.begin(), m_vertices.end());
+    }
+
+    bool ConvexHull3D::verifyHull() const
+    {
+        for(auto& face : m_hullFaces)
+        {
+            if(face.m_deleted)
+            {
+                continue;
+            }
+            for(unsigned int i = 0; i < m_p.cols(); ++i)
+            {
+                if(distance(face, i) > 10 * m_tolerance)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void ConvexHull3D::getVertices(Matrix3Dyn& vertices) const
+    {
+        vertices.resize(3, m_vertices.size());
+        for(std::size_t i = 0; i < m_vertices.size(); ++i)
+        {
+            vertices.col(i) = m_p.col(m_vertices[i]);
+        }
+    }
+
+    void ConvexHull3D::getHull(Matrix3Dyn& vertices, std::vector<Face>& faces) const
+    {
+        getVertices(vertices);
+        faces.resize(m_faces.size());
+        for(std::size_t f = 0; f < m_faces.size(); ++f)
+        {
+            for(unsigned int k = 0; k < 3; ++k)
+            {
+                auto it     = std::lower_bound(m_vertices.begin(), m_vertices.end(), m_faces[f][k]);
+                faces[f][k] = static_cast<unsigned int>(it - m_vertices.begin());
+            }
+        }
+    }
+}  // namespace ApproxMVBB
@@ -0,0 +1,704 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz
+//  (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "ApproxMVBB/ExactMVBB.hpp"
+#include "ApproxMVBB/AngleFunctions.hpp"
+#include "ApproxMVBB/ProjectedPointSet.hpp"
+
+namespace ApproxMVBB
+{
+    namespace
+    {
+        constexpr unsigned int bisectionSteps = 100;  ///< Bisection steps per root of polynomialRoots.
+        constexpr PREC contactOffset          = 1e-9; ///< The contacts of a piece are taken this angle after its start.
+
+        /** Polynomial `sum_k m_c[k] * u^k` of degree at most 7 */
+        struct Polynomial
+        {
+            std::array<PREC, 8> m_c{};
+            int m_degree = 0;
+
+            inline PREC operator()(PREC u) const
+            {
+                PREC v = m_c[m_degree];
+                for(int k = m_degree - 1; k >= 0; --k)
+                {
+                    v = v * u + m_c[k];
+                }
+                return v;
+            }
+
+            Polynomial derivative() const
+            {
+                Polynomial d;
+                d.m_degree = std::max(m_degree - 1, 0);
+                for(int k = 1; k <= m_degree; ++k)
+                {
+                    d.m_c[k - 1] = k * m_c[k];
+                }
+                return d;
+            }
+
+            Polynomial operator*(const Polynomial& other) const
+            {
+                Polynomial p;
+                p.m_degree = std::min(m_degree + other.m_degree, 7);
+                for(int i = 0; i <= m_degree; ++i)
+                {
+                    for(int j = 0; j <= other.m_degree && i + j <= 7; ++j)
+                    {
+                        p.m_c[i + j] += m_c[i] * other.m_c[j];
+                    }
+                }
+                return p;
+            }
+
+            Polynomial operator-(const Polynomial& other) const
+            {
+                Polynomial p;
+                p.m_degree = std::max(m_degree, other.m_degree);
+                for(int k = 0; k <= p.m_degree; ++k)
+                {
+                    p.m_c[k] = m_c[k] - other.m_c[k];
+                }
+                return p;
+            }
+        };
+
+        /** Appends the real roots of `f` in `[lo,hi]` in ascending order to `roots`.
+            The roots of the derivative split `[lo,hi]` into monotone pieces with at most one root each,
+            which is found by bisection. Leading coefficients which do not matter on `[lo,hi]` are dropped. */
+        void polynomialRoots(Polynomial f, PREC lo, PREC hi, std::array<PREC, 8>& roots, int& nRoots)
+        {
+            PREC x = std::max(std::abs(lo), std::abs(hi)), scale = 0, power = 1;
+            for(int k = 0; k <= f.m_degree; ++k, power *= x)
+            {
+                scale += std::abs(f.m_c[k]) * power;
+            }
+            while(f.m_degree > 0 &&
+                  std::abs(f.m_c[f.m_degree]) * std::pow(x, f.m_degree) <= std::numeric_limits<PREC>::epsilon() * scale)
+            {
+                --f.m_degree;
+            }
+            if(f.m_degree == 0)
+            {
+                return;
+            }
+            if(f.m_degree == 1)
+            {
+                PREC u = -f.m_c[0] / f.m_c[1];
+                if(u >= lo && u <= hi)
+                {
+                    roots[nRoots++] = u;
+                }
+                return;
+            }
+
+            std::array<PREC, 8> ends;
+            int nEnds = 1;
+            ends[0]   = lo;
+            polynomialRoots(f.derivative(), lo, hi, ends, nEnds);
+            ends[nEnds++] = hi;
+
+            for(int k = 0; k + 1 < nEnds; ++k)
+            {
+                PREC a = ends[k], b = ends[k + 1];
+                PREC fa = f(a), fb = f(b);
+                if(fa == 0)
+                {
+                    if(nRoots == 0 || roots[nRoots - 1] < a)
+                    {
+                        roots[nRoots++] = a;
+                    }
+                    continue;
+                }
+                if((fa < 0) == (fb < 0) || fb == 0)
+                {
+                    continue;
+                }
+                for(unsigned int i = 0; i < bisectionSteps && a < b; ++i)
+                {
+                    PREC m = 0.5 * (a + b);
+                    if(m <= a || m >= b)
+                    {
+                        break;
+                    }
+                    if((f(m) < 0) == (fa < 0))
+                    {
+                        a = m;
+                    }
+                    else
+                    {
+                        b = m;
+                    }
+                }
+                roots[nRoots++] = 0.5 * (a + b);
+            }
+            if(f(hi) == 0 && (nRoots == 0 || roots[nRoots - 1] < hi))
+            {
+                roots[nRoots++] = hi;
+            }
+        }
+
+        /** Harmonic `m_k + m_a * cos(theta) + m_b * sin(theta)` */
+        struct Harmonic
+        {
+            PREC m_k, m_a, m_b;
+
+            /** Quadratic `(1 + u^2) * h(thetaM + 2 * atan(u))` (tangent half-angle substitution) */
+            Polynomial quadratic(PREC thetaM) const
+            {
+                PREC c = std::cos(thetaM), s = std::sin(thetaM);
+                PREC a = m_a * c + m_b * s, b = m_b * c - m_a * s;
+                Polynomial p;
+                p.m_degree = 2;
+                p.m_c      = {{m_k + a, 2 * b, m_k - a}};
+                return p;
+            }
+        };
+
+        /** Harmonic in `theta = 2t` of the product `(a0 * cos(t) + b0 * sin(t)) * (a1 * cos(t) + b1 * sin(t))` */
+        inline Harmonic productHarmonic(PREC a0, PREC b0, PREC a1, PREC b1)
+        {
+            const PREC half = 0.5;
+            return Harmonic{half * (a0 * a1 + b0 * b1), half * (a0 * a1 - b0 * b1), half * (a0 * b1 + b0 * a1)};
+        }
+
+        /** First angle `s > t` at which `k + a * cos(m * s) + b * sin(m * s)` crosses zero upwards
+            (infinity if there is none) */
+        PREC nextUpwardCrossing(PREC k, PREC a, PREC b, PREC m, PREC t)
+        {
+            PREC r = std::sqrt(a * a + b * b);
+            if(r <= std::abs(k))
+            {
+                return std::numeric_limits<PREC>::infinity();
+            }
+            const PREC period = static_cast<PREC>(2 * M_PI) / m;
+            PREC s            = (std::atan2(b, a) - std::acos(-k / r)) / m;
+            s += period * std::ceil((t - s) / period);
+            if(s <= t)
+            {
+                s += period;
+            }
+            return s;
+        }
+
+        /** Arc of the outward normals `cos(t) * m_n0 + sin(t) * m_w, t in [0,m_alpha]` of the supporting
+            planes which contain the hull edge with direction `m_e`. */
+        struct EdgeArc
+        {
+            EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+            Vector3 m_e;   ///< Unit edge direction.
+            Vector3 m_p;   ///< A vertex of the edge.
+            Vector3 m_n0;  ///< Normal of the first face at the edge.
+            Vector3 m_w;   ///< Unit vector perpendicular to `m_e` and `m_n0` towards the second face.
+            PREC m_alpha;  ///< Angle between the normals of the two faces.
+
+            inline Vector3 normal(PREC t) const
+            {
+                return std::cos(t) * m_n0 + std::sin(t) * m_w;
+            }
+
+            /** Angle of the unit vector `n` (perpendicular to `m_e`) on the arc */
+            inline PREC angle(const Vector3& n) const
+            {
+                return std::atan2(n.dot(m_w), n.dot(m_n0));
+            }
+        };
+
+        /** Extent of the box with the orthonormal axes (rows of) `A_KI` around `vertices` */
+        Vector3 boxExtent(const Matrix33& A_KI, const Matrix3Dyn& vertices)
+        {
+            Vector3 minPoint = A_KI * vertices.col(0);
+            Vector3 maxPoint = minPoint;
+            Vector3 K_p;
+            for(decltype(vertices.cols()) i = 1; i < vertices.cols(); ++i)
+            {
+                K_p      = A_KI * vertices.col(i);
+                minPoint = minPoint.cwiseMin(K_p);
+                maxPoint = maxPoint.cwiseMax(K_p);
+            }
+            return maxPoint - minPoint;
+        }
+
+        /** Box with the first face flush with the edge of `arc1` (normal at `t`) and the second
+            face flush with the edge of `arc2` (normal `sign * m_e x normal` of `arc2`).
+            Returns the rows of `A_KI`. */
+        Matrix33 edgePairAxes(const EdgeArc& arc1, const EdgeArc& arc2, PREC sign, PREC t)
+        {
+            Matrix33 A_KI;
+            Vector3 n1 = arc1.normal(t);
+            Vector3 n2 = sign * arc2.m_e.cross(n1).normalized();
+            A_KI.row(0) = n1;
+            A_KI.row(1) = n2;
+            A_KI.row(2) = n1.cross(n2);
+            return A_KI;
+        }
+
+        /** Appends the intervals `[t0,t1]` of `arc1` for which the normal `n2 = sign * arc2.m_e x n1`
+            of the second face lies on `arc2`, as `(t0,t1,sign)`.
+            The normal `n2` is parallel to an end of `arc2` exactly if `n1` is perpendicular to the
+            corresponding face normal, these (at most 4) angles split `arc1` into pieces on which
+            the feasibility does not change. */
+        void feasibleIntervals(const EdgeArc& arc1, const EdgeArc& arc2, std::vector<std::array<PREC, 3>>& intervals)
+        {
+            // Sorted splits: the zeros of each end are `pi` apart, thus at most one lies in `(0,alpha)`
+            std::array<PREC, 4> splits;
+            std::size_t nSplits = 0;
+            splits[nSplits++]   = 0;
+
+            const PREC pi = static_cast<PREC>(M_PI);
+            const std::array<Vector3, 2> ends{{arc2.m_n0, arc2.normal(arc2.m_alpha)}};
+            for(const Vector3& n : ends)
+            {
+                // cos(t) * n0.n + sin(t) * w.n = 0
+                PREC t = std::atan2(-arc1.m_n0.dot(n), arc1.m_w.dot(n));
+                for(int k = -1; k <= 1; ++k)
+                {
+                    PREC s = t + k * pi;
+                    if(s > 0 && s < arc1.m_alpha && nSplits + 1 < splits.size())
+                    {
+                        std::size_t i = nSplits++;
+                        for(; i > 0 && splits[i - 1] > s; --i)
+                        {
+                            splits[i] = splits[i - 1];
+                        }
+                        splits[i] = s;
+                    }
+                }
+            }
+            splits[nSplits++] = arc1.m_alpha;
+
+            for(std::size_t k = 0; k + 1 < nSplits; ++k)
+            {
+                PREC t0 = splits[k], t1 = splits[k + 1];
+                if(t1 <= t0)
+                {
+                    continue;
+                }
+                Vector3 n2 = arc2.m_e.cross(arc1.normal(0.5 * (t0 + t1)));
+                if(n2.squaredNorm() <= std::numeric_limits<PREC>::epsilon())
+                {
+                    continue;
+                }
+                PREC sign = 1;
+                PREC phi  = arc2.angle(n2);
+                if(phi < 0 || phi > arc2.m_alpha)
+                {
+                    sign = -1;
+                    phi  = arc2.angle(-n2);
+                    if(phi < 0 || phi > arc2.m_alpha)
+                    {
+                        continue;
+                    }
+                }
+                intervals.push_back({{t0, t1, sign}});
+            }
+        }
+
+        /** Lower bound of the volume of edgePairAxes on the interval `[t0,t1]`: the axes turn at most
+            by `d` from the center of the interval (`d0 = (t1-t0)/2`, `d1 = d0 / min|arc2.m_e x n1|`,
+            `d2 = d0 + d1`), which changes each extent by at most `2 * radius * d` (`radius` of a ball
+            around the vertices). */
+        PREC edgePairLowerBound(const EdgeArc& arc1,
+                                const EdgeArc& arc2,
+                                const std::array<PREC, 3>& interval,
+                                const Matrix3Dyn& vertices,
+                                PREC radius)
+        {
+            const PREC t0 = interval[0], t1 = interval[1], sign = interval[2];
+            const PREC tm = 0.5 * (t0 + t1), d0 = 0.5 * (t1 - t0);
+
+            // |arc2.m_e . n1| changes at most by d0
+            PREC cosMax   = std::min(PREC(1), std::abs(arc2.m_e.dot(arc1.normal(tm))) + d0);
+            PREC crossMin = std::sqrt(1 - cosMax * cosMax);
+            if(crossMin <= 0)
+            {
+                return 0;
+            }
+            PREC d1 = d0 / crossMin;
+
+            Vector3 change(d0, d1, d0 + d1);
+            Vector3 extent = boxExtent(edgePairAxes(arc1, arc2, sign, tm), vertices) - 2 * radius * change;
+            return extent.cwiseMax(0).prod();
+        }
+
+        /** Angle in `[t0,t1]` with the minimal volume of edgePairAxes (in closed form).
+            Besides the two faces flush with the edges, the box touches the hull with the opposite
+            face of the first (vertex `a1`), the opposite face of the second (`a2`) and the two
+            faces perpendicular to the common edge direction (`a3`, `b3`).
+            The interval is split at the angles where these vertices change (the projections of
+            the other vertices cross the ones of the contacts, in closed form). On each piece the
+            extents are `L1 = n1.(p1 - a1)`, `L2 = n2.(p2 - a2)` and `L3 = n3.(b3 - a3)` and the volume
+            is `P(theta) * Q(theta) / R(theta)` with harmonics `P,Q,R` in `theta = 2t`
+            (`R = |e2 x n1|^2`). With `u = tan((theta - thetaM) / 2)` around the center `thetaM` of the
+            piece it becomes `p(u) q(u) / (r(u) (1 + u^2))` with quadratics `p,q,r`, the stationary points
+            are the roots of a polynomial of degree 7. The volume is evaluated at these roots and at the
+            ends of the pieces. */
+        PREC minimizeEdgePair(const EdgeArc& arc1,
+                              const EdgeArc& arc2,
+                              const std::array<PREC, 3>& interval,
+                              const Matrix3Dyn& vertices,
+                              PREC& volume)
+        {
+            const PREC t0 = interval[0], t1 = interval[1], sign = interval[2];
+            const Vector3& n0 = arc1.m_n0;
+            const Vector3& w  = arc1.m_w;
+            const Vector3& e2 = arc2.m_e;
+
+            PREC bestT = t0;
+            volume     = std::numeric_limits<PREC>::max();
+            auto evaluate = [&](PREC t) {
+                if(e2.cross(arc1.normal(t)).squaredNorm() <= std::numeric_limits<PREC>::epsilon())
+                {
+                    return;
+                }
+                PREC v = boxExtent(edgePairAxes(arc1, arc2, sign, t), vertices).prod();
+                if(v < volume)
+                {
+                    volume = v;
+                    bestT  = t;
+                }
+            };
+            evaluate(t0);
+
+            // n1.e2 = a * cos(t) + b * sin(t), R = 1 - (n1.e2)^2
+            const PREC a     = n0.dot(e2), b = w.dot(e2);
+            const Harmonic r = [&]() {
+                Harmonic h = productHarmonic(a, b, a, b);
+                return Harmonic{1 - h.m_k, -h.m_a, -h.m_b};
+            }();
+            // n2.x = sign * n1.(x x e2) / |e2 x n1| with n0.(x x e2) = x.(e2 x n0)
+            const Vector3 e2n0 = e2.cross(n0), e2w = e2.cross(w);
+
+            using Index           = decltype(vertices.cols());
+            const Index nVertices = vertices.cols();
+            PREC t                = t0;
+            for(Index piece = 0; t < t1 && piece < 4 * nVertices + 16; ++piece)
+            {
+                // Contacts just after t
+                PREC ts       = std::min(t + contactOffset, PREC(0.5) * (t + t1));
+                Matrix33 A_KI = edgePairAxes(arc1, arc2, sign, ts);
+                Index a1 = 0, a2 = 0, a3 = 0, b3 = 0;
+                Vector3 minPoint = A_KI * vertices.col(0), maxPoint = minPoint, K_p;
+                for(Index i = 1; i < nVertices; ++i)
+                {
+                    K_p = A_KI * vertices.col(i);
+                    if(K_p(0) < minPoint(0))
+                    {
+                        minPoint(0) = K_p(0);
+                        a1          = i;
+                    }
+                    if(K_p(1) < minPoint(1))
+                    {
+                        minPoint(1) = K_p(1);
+                        a2          = i;
+                    }
+                    if(K_p(2) < minPoint(2))
+                    {
+                        minPoint(2) = K_p(2);
+                        a3          = i;
+                    }
+                    if(K_p(2) > maxPoint(2))
+                    {
+                        maxPoint(2) = K_p(2);
+                        b3          = i;
+                    }
+                }
+
+                // End of the piece: first vertex which passes a contact. The projections on n1 and n2
+                // are `A cos(t) + B sin(t)` (zeros `pi` apart, the piece is shorter), a crossing exists
+                // exactly if the sign at the end changed. The ones on n3 are `K + A cos(2t) + B sin(2t)`.
+                PREC tNext = t1, cNext = std::cos(t1), sNext = std::sin(t1);
+                auto update = [&](PREC tCross) {
+                    if(tCross < tNext)
+                    {
+                        tNext = tCross;
+                        cNext = std::cos(tNext);
+                        sNext = std::sin(tNext);
+                    }
+                };
+                for(Index i = 0; i < nVertices; ++i)
+                {
+                    Vector3 x = vertices.col(i) - vertices.col(a1);
+                    PREC A = n0.dot(x), B = w.dot(x);
+                    if(A * cNext + B * sNext < 0)
+                    {
+                        update(nextUpwardCrossing(0, -A, -B, 1, ts));
+                    }
+
+                    x = vertices.col(i) - vertices.col(a2);
+                    A = sign * x.dot(e2n0);
+                    B = sign * x.dot(e2w);
+                    if(A * cNext + B * sNext < 0)
+                    {
+                        update(nextUpwardCrossing(0, -A, -B, 1, ts));
+                    }
+
+                    // n3.x = sign * (e2.x - (n1.e2) (n1.x)) / |e2 x n1|
+                    for(Index c : {b3, a3})
+                    {
+                        x          = vertices.col(i) - vertices.col(c);
+                        Harmonic h = productHarmonic(a, b, n0.dot(x), w.dot(x));
+                        PREC s     = (c == b3 ? sign : -sign);
+                        update(nextUpwardCrossing(s * (e2.dot(x) - h.m_k), -s * h.m_a, -s * h.m_b, 2, ts));
+                    }
+                }
+
+                // Stationary points of the volume on [t,tNext]
+                Vector3 d1  = arc1.m_p - vertices.col(a1);
+                Vector3 d2  = (arc2.m_p - vertices.col(a2)).cross(e2);
+                Vector3 d3  = vertices.col(b3) - vertices.col(a3);
+                Harmonic p  = productHarmonic(n0.dot(d1), w.dot(d1), n0.dot(d2), w.dot(d2));
+                Harmonic hq = productHarmonic(a, b, n0.dot(d3), w.dot(d3));
+                Harmonic q{e2.dot(d3) - hq.m_k, -hq.m_a, -hq.m_b};
+
+                PREC tm     = 0.5 * (t + tNext);
+                PREC thetaM = 2 * tm;
+                PREC U      = std::tan(0.5 * (tNext - t));
+                Polynomial one;
+                one.m_degree = 2;
+                one.m_c      = {{1, 0, 1}};
+                Polynomial N = p.quadratic(thetaM) * q.quadratic(thetaM);
+                Polynomial D = r.quadratic(thetaM) * one;
+                Polynomial F = N.derivative() * D - N * D.derivative();
+
+                std::array<PREC, 8> roots;
+                int nRoots = 0;
+                polynomialRoots(F, -U, U, roots, nRoots);
+                for(int k = 0; k < nRoots; ++k)
+                {
+                    evaluate(tm + std::atan(roots[k]));
+                }
+                evaluate(tNext);
+                t = tNext;
+            }
+            return bestT;
+        }
+
+        /** Minimal box in the direction of the normal of the plane (or a line) of degenerate hulls */
+        OOBB degenerateMVBB(const Matrix3Dyn& vertices)
+        {
+            auto n = vertices.cols();
+            Vector3 dir(0, 0, 1);
+            if(n >= 2)
+            {
+                Vector3 line = vertices.col(n - 1) - vertices.col(0);
+                if(line.squaredNorm() > 0)
+                {
+                    dir = line.unitOrthogonal();
+                }
+                PREC maxArea = 0;
+                for(decltype(n) i = 1; i + 1 < n; ++i)
+                {
+                    Vector3 normal = line.cross(vertices.col(i) - vertices.col(0));
+                    if(normal.norm() > maxArea)
+                    {
+                        maxArea = normal.norm();
+                        dir     = normal / maxArea;
+                    }
+                }
+            }
+            ProjectedPointSet proj;
+            return proj.computeMVBB(dir, vertices);
+        }
+    }  // namespace
+
+    namespace details
+    {
+        OOBB exactMVBBOfHull(const Matrix3Dyn& vertices, const std::vector<ConvexHull3D::Face>& faces)
+        {
+            if(faces.empty())
+            {
+                return degenerateMVBB(vertices);
+            }
+
+            // Face normals
+            StdVecAligned<Vector3> normals(faces.size());
+            for(std::size_t f = 0; f < faces.size(); ++f)
+            {
+                const auto& face = faces[f];
+                normals[f]       = (vertices.col(face[1]) - vertices.col(face[0]))
+                                 .cross(vertices.col(face[2]) - vertices.col(face[0]))
+                                 .normalized();
+            }
+
+            // Edges: the directed edge `a -> b` of one face is `b -> a` in the neighbor face
+            struct HalfEdge
+            {
+                unsigned int m_min, m_max, m_face;
+                bool m_forward;  ///< `m_min -> m_max` in `m_face`.
+                bool operator<(const HalfEdge& other) const
+                {
+                    return m_min < other.m_min || (m_min == other.m_min && m_max < other.m_max);
+                }
+            };
+            std::vector<HalfEdge> halfEdges;
+            halfEdges.reserve(3 * faces.size());
+            for(unsigned int f = 0; f < faces.size(); ++f)
+            {
+                for(unsigned int k = 0; k < 3; ++k)
+                {
+                    unsigned int a = faces[f][k], b = faces[f][(k + 1) % 3];
+                    halfEdges.push_back(HalfEdge{std::min(a, b), std::max(a, b), f, a < b});
+                }
+            }
+            std::sort(halfEdges.begin(), halfEdges.end());
+
+            // Arcs of the edges which are not flat (coplanar triangles)
+            const PREC flatAngle = 1e3 * std::numeric_limits<PREC>::epsilon();
+            StdVecAligned<EdgeArc> arcs;
+            for(std::size_t k = 0; k + 1 < halfEdges.size(); ++k)
+            {
+                const HalfEdge& h1 = halfEdges[k];
+                const HalfEdge& h2 = halfEdges[k + 1];
+                if(h1.m_min != h2.m_min || h1.m_max != h2.m_max)
+                {
+                    continue;
+                }
+                ++k;
+
+                EdgeArc arc;
+                arc.m_e       = (vertices.col(h1.m_max) - vertices.col(h1.m_min)).normalized();
+                arc.m_p       = vertices.col(h1.m_min);
+                arc.m_n0      = normals[h1.m_face];
+                Vector3 n1    = normals[h2.m_face];
+                arc.m_w       = arc.m_e.cross(arc.m_n0).normalized();
+                if(arc.m_w.dot(n1) < 0)
+                {
+                    arc.m_w = -arc.m_w;
+                }
+                arc.m_alpha = arc.angle(n1);
+                if(arc.m_alpha > flatAngle)
+                {
+                    arcs.push_back(arc);
+                }
+            }
+
+            // Candidate directions of a face flush with a hull face or a box edge on a hull edge
+            StdVecAligned<Vector3> directions(normals);
+            for(const EdgeArc& arc : arcs)
+            {
+                directions.push_back(arc.m_e);
+            }
+
+            // Ball around the vertices for edgePairLowerBound
+            Vector3 center = 0.5 * (vertices.rowwise().minCoeff() + vertices.rowwise().maxCoeff());
+            PREC radius    = (vertices.colwise() - center).colwise().norm().maxCoeff();
+
+            OOBB oobb;
+            PREC volume         = std::numeric_limits<PREC>::max();
+            long long int nDirs = static_cast<long long int>(directions.size());
+            long long int nArcs = static_cast<long long int>(arcs.size());
+
+            // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+            #pragma omp parallel ApproxMVBB_OPENMP_NUMTHREADS
+#endif
+            // clang-format on
+            {
+                ProjectedPointSet proj;
+                OOBB threadOOBB;
+                PREC threadVolume = std::numeric_limits<PREC>::max();
+
+                // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+                #pragma omp for schedule(dynamic, 16)
+#endif
+                // clang-format on
+                for(long long int i = 0; i < nDirs; ++i)
+                {
+                    OOBB o = proj.computeMVBB(directions[i], vertices);
+                    if(o.volume() < threadVolume)
+                    {
+                        threadOOBB   = o;
+                        threadVolume = o.volume();
+                    }
+                }
+
+                // The best face box bounds the edge pairs of all threads
+                // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+                #pragma omp critical
+#endif
+                // clang-format on
+                {
+                    if(threadVolume < volume)
+                    {
+                        oobb   = threadOOBB;
+                        volume = threadVolume;
+                    }
+                }
+                // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+                #pragma omp barrier
+#endif
+                // clang-format on
+                threadVolume = volume;
+
+                std::vector<std::array<PREC, 3>> intervals;
+                // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+                #pragma omp for schedule(dynamic, 4)
+#endif
+                // clang-format on
+                for(long long int i = 0; i < nArcs; ++i)
+                {
+                    for(long long int j = i + 1; j < nArcs; ++j)
+                    {
+                        intervals.clear();
+                        feasibleIntervals(arcs[i], arcs[j], intervals);
+                        for(const auto& interval : intervals)
+                        {
+                            if(edgePairLowerBound(arcs[i], arcs[j], interval, vertices, radius) >= threadVolume)
+                            {
+                                continue;
+                            }
+                            PREC v;
+                            PREC t = minimizeEdgePair(arcs[i], arcs[j], interval, vertices, v);
+                            if(v >= threadVolume)
+                            {
+                                continue;
+                            }
+                            // The rectangle around the common edge direction is at least as small
+                            Matrix33 A_KI = edgePairAxes(arcs[i], arcs[j], interval[2], t);
+                            OOBB o        = proj.computeMVBB(A_KI.row(2).transpose(), vertices);
+                            if(o.volume() < threadVolume)
+                            {
+                                threadOOBB   = o;
+                                threadVolume = o.volume();
+                            }
+                        }
+                    }
+                }
+
+                // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+                #pragma omp critical
+#endif
+                // clang-format on
+                {
+                    if(threadVolume < volume)
+                    {
+                        oobb   = threadOOBB;
+                        volume = threadVolume;
+                    }
+                }
+            }
+
+            return oobb;
+        }
+    }  // namespace details
+}  // namespace ApproxMVBB
@@ -0,0 +1,60 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz
+//  (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#include "ApproxMVBB/GridDirections.hpp"
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <type_traits>
+
+#include "ApproxMVBB/GreatestCommonDivisor.hpp"
+
+namespace ApproxMVBB
+{
+    namespace details
+    {
+        const std::vector<GridDirection>& primitiveGridDirections(unsigned int gridSize)
+        {
+            static std::mutex mutex;
+            static std::map<unsigned int, std::vector<GridDirection>> tables;  // nodes never move
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = tables.find(gridSize);
+            if(it != tables.end())
+            {
+                return it->second;
+            }
+
+            std::vector<GridDirection>& dirs = tables[gridSize];
+            int g                            = static_cast<int>(gridSize);
+            for(int x = -g; x <= g; ++x)
+            {
+                for(int y = -g; y <= g; ++y)
+                {
+                    for(int z = 0; z <= g; ++z)
+                    {
+                        if(MathFunctions::gcd3(x, y, z) > 1 || ((x == 0) && (y == 0) && (z == 0)))
+                        {
+                            continue;
+                        }
+                        // (x,y,0) and (-x,-y,0) give the same box
+                        if(z == 0 && (y < 0 || (y == 0 && x < 0)))
+                        {
+                            continue;
+                        }
+                        dirs.push_back(GridDirection{{x, y, z}});
+                    }
+                }
+            }
+            return dirs;
+        }
+    }  // namespace details
+}  // namespace ApproxMVBB
@@ -8,11 +8,13 @@
 //  file, You can obtain one at http://mozilla.org/MPL/2.0/.
 // ========================================================================================
 
+#include <algorithm>
+
 #include "ApproxMVBB/MinAreaRectangle.hpp"
 
 namespace ApproxMVBB
 {
-    void MinAreaRectangle::compute()
+    void MinAreaRectangle::compute(ConvexHull2D::Algorithm algorithm)
     {
         // Compute minimum area rectangle
 
@@ -26,7 +28,7 @@ namespace ApproxMVBB
         }
 
         // Generate Convex Hull
-        m_convh.compute();
+        m_convh.compute(algorithm);
         ApproxMVBB_ASSERTMSG(m_convh.verifyHull(), "Convex hull not ok!")
 
             // Compute Rectangle
@@ -39,8 +41,6 @@ namespace ApproxMVBB
 
     void MinAreaRectangle::computeRectangle()
     {
-        // Copy Points;
-        m_hullIdx    = m_convh.getIndices();
         auto nPoints = m_hullIdx.size();
 
         // std::cout << "Convex hull points:" << nPoints << std::endl;
@@ -67,138 +67,76 @@ namespace ApproxMVBB
         }
 
         // Performing Rotating Calipers method
-        // 1. find the vertices with the minimum and maximum x an y coordinates.
-        //    These vertices (points) will be denoted by {PI, PJ, PK, PL}
-        // 2. construct CALL and CALJ as the first set of calipers parallel to the
-        // x-axis,
-        //    and CALI and CALK as the second set of calipers parallel to the y-axis
-        // 3. create for every CALX a next caliper,
-        //    NEXT_CALX, based on the next point in the convex hull and calculate the
-        //    tangent of CALX and it's NEXT_CALX
-        // 4. get the smallest positive tangent between all CALX and NEXT_CALX and
-        // rotate every caliper by that smallest gradient
-        // 5. repeat step 3 and 4 untill the calipers have turned more then 90 degrees
-
-        // We implement this algorithm a bit differently:
-        // 1. Compute all angles of all edges angle[i] is angle of edge p[i],p[i+1].
-        // 2. Rotatate the first caliper A from edge to edge.
-        // 3. Determine all new angles for B,C,D such that it forms a box (rotation of
-        // pi from angle of caliper A)
-        // 4. Determine for each caliper I  the location (the corresponding vertex
-        // index) where the
-        //    caliper I forms a tangent (starting from the currend index).
-        // 5. Determine the box by intersecting the calipers.
-        // 6. Compare to area to minimum and return to 2.
-
-        // Calcualte all edge angles
-
-        m_angles.resize(nPoints);
-        for(unsigned int i = 0; i < nPoints; ++i)
-        {
-            m_angles[i] = PointFunctions::getAngle(m_p.col(m_hullIdx[i]), m_p.col(m_hullIdx[(i + 1) % nPoints]));
-            // std::cout << "angle: " << m_angles[i] << std::endl;
-        }
+        // The hull is counter-clockwise and without collinear points.
+        // For every edge e[i] = p[i+1]-p[i] (caliper A) the three other calipers are the
+        // vertices B,C,D with maximal extent in direction e[i], maximal extent in the normal
+        // direction n[i] (pointing inwards) and minimal extent in direction e[i].
+        // Since the edge directions turn monotonically, the vertices B,C,D only move
+        // forward while rotating over all edges (O(n) in total) and are found by
+        // the signs of dot/cross products with the edge directions (no angles needed).
 
-        // 2. Construct 4 Calipers
-        Caliper calipers[4];
-        // Set A
-        calipers[0].m_idx   = 0;
-        calipers[0].m_ptIdx = m_hullIdx[0];
-        // Init A,B,C,D
-        updateCalipers(m_angles[0], calipers);
+        auto edge = [&](unsigned int j) -> Vector2 {
+            return m_p.col(m_hullIdx[(j + 1) % nPoints]) - m_p.col(m_hullIdx[j % nPoints]);
+        };
 
-        Box2d box;
-        // Init minBox
-        getBox(calipers, m_minBox);
+        // Calipers B,C,D (unwrapped indices into m_hullIdx)
+        unsigned int b = 0, c = 0, d = 0;
 
-        // Rotate calipers over all edges and take minimum box
-        for(unsigned int i = 1; i < nPoints; ++i)
+        Box2d box;
+        bool first = true;
+        for(unsigned int i = 0; i < nPoints; ++i)
         {
-            updateCalipers(m_angles[i], calipers);
-            // Get Box from Calipers
-            getBox(calipers, box);
-
-            if(box.m_area < m_minBox.m_area)
+            Vector2 e = edge(i);
+            if(e.isZero(0))
             {
-                m_minBox = box;
+                continue;
             }
-        }
-    }
-
-    // determine the vertex v for which the edge angle is greater than c.m_currAngle
-    // the find algroithm starts at c.m_idx
-    void MinAreaRectangle::findVertex(Caliper& c)
-    {
-        PREC matchAngle = c.m_currAngle;  // between 0-2pi
-        // std::cout << "Match Angle: " << matchAngle << std::endl;
-
-        unsigned int currIdx = c.m_idx;
-
-        PREC currAngle = m_angles[currIdx];  // all between 0-2pi
-        PREC nextAngle;
 
-        unsigned int nPoints = m_hullIdx.size();
-        bool found           = false;
-        unsigned int i       = 0;
-        while(!found && i < nPoints)
-        {
-            currIdx = (currIdx + 1) % nPoints;
-            // std::cout << "c: " << currIdx << std::endl;
-            nextAngle = m_angles[currIdx];
-            // std::cout << "diff: " << std::abs(currAngle-nextAngle) << std::endl;
-            //                                         curr       next
-            // if we are not at the boundary [ ..., 45 degree, 50 degree , ....]
-            // and in
-            if(nextAngle > currAngle)
+            // B: walk while the extent in direction e grows
+            b = std::max(b, i);
+            while(e.dot(edge(b)) > 0.0 && b < i + nPoints)
+            {
+                ++b;
+            }
+            // C: walk while the extent in direction n grows
+            c = std::max(c, b);
+            while(e(0) * edge(c)(1) - e(1) * edge(c)(0) > 0.0 && c < i + nPoints)
             {
-                // std::cout << " greater" <<std::endl;
-                found = (currAngle < matchAngle && matchAngle <= nextAngle);
+                ++c;
             }
-            else
+            // D: walk while the extent in direction e shrinks
+            d = std::max(d, c);
+            while(e.dot(edge(d)) < 0.0 && d < i + nPoints)
             {
-                // std::cout << " boundary" <<std::endl;
-                //                                     curr       next
-                // if we are at the boundary [ ..., 359 degree] [ 5 degree , .... ]
-                // skip this if we have an angle difference |curr -next| < eps
-                // this might happen due to floating point nonsense
-                found = (std::abs(currAngle - nextAngle) > 1e-10) && (currAngle < matchAngle || matchAngle <= nextAngle);
+                ++d;
             }
 
-            currAngle = nextAngle;
-            ++i;
-        }
+            getBox(i, b % nPoints, c % nPoints, d % nPoints, e, box);
 
-        if(found)
-        {
-            c.m_idx   = currIdx;
-            c.m_ptIdx = m_hullIdx[currIdx];
-            // std::cout << "caliper idx:" << currIdx << std::endl;
-        }
-        else
-        {
-            std::stringstream ss;
-            for(auto& a : m_angles)
+            // Areas which are equal up to round-off keep the first box
+            if(first || box.m_area < m_minBox.m_area * (1.0 - 1e-12))
             {
-                ss << a << ",";
+                m_minBox = box;
+                first    = false;
             }
-            ApproxMVBB_ERRORMSG("Could not find vertex with angle greater than: " << matchAngle
-                                                                                  << "in angles: " << ss.str());
         }
     }
 
-    void MinAreaRectangle::getBox(Caliper (&c)[4], Box2d& box)
+    void MinAreaRectangle::getBox(unsigned int a, unsigned int b, unsigned int c, unsigned int d, const Vector2& e, Box2d& box)
     {
-        using namespace PointFunctions;
-        // Intersect Caliper A with B,
-        box.m_u = intersectLines(m_p.col(c[0].m_ptIdx), c[0].m_currAngle, m_p.col(c[1].m_ptIdx), c[1].m_currAngle);
-        // Intersect Caliper D with C,
-        box.m_v = intersectLines(m_p.col(c[3].m_ptIdx), c[3].m_currAngle, m_p.col(c[2].m_ptIdx), c[2].m_currAngle);
+        // Unit directions of the calipers A (u) and D (n)
+        Vector2 u = e.normalized();
+        Vector2 n(-u(1), u(0));
+
+        auto pA = m_p.col(m_hullIdx[a]);
+        auto pD = m_p.col(m_hullIdx[d]);
 
-        // Intersect Caliper A with D,
-        box.m_p = intersectLines(m_p.col(c[0].m_ptIdx), c[0].m_currAngle, m_p.col(c[3].m_ptIdx), c[3].m_currAngle);
+        // Intersection of caliper A with D
+        box.m_p = pA + u * u.dot(pD - pA);
+        // Intersection of caliper A with B and of caliper D with C (relative to m_p)
+        box.m_u = u * u.dot(m_p.col(m_hullIdx[b]) - pD);
+        box.m_v = n * n.dot(m_p.col(m_hullIdx[c]) - pA);
 
-        box.m_u -= box.m_p;  //(p1-p0)
-        box.m_v -= box.m_p;  //(p2-p0)
         box.m_area = box.m_u.norm() * box.m_v.norm();
     }
 }  // namespace ApproxMVBB
@@ -0,0 +1,463 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz
+//  (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#include "ApproxMVBB/PointCloudFile.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#if defined(ApproxMVBB_OPENMP_SUPPORT) && defined(_OPENMP)
+#    include <omp.h>
+#endif
+
+#if(defined _WIN32) || (defined WIN32)
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace ApproxMVBB
+{
+    namespace details
+    {
+        bool isBigEndian()
+        {
+            const std::uint16_t i = 1;
+            char c;
+            std::memcpy(&c, &i, 1);
+            return c == 0;
+        }
+
+        inline bool isSpace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+        }
+
+        inline bool isDigit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        /** Parse the number in [it, end) which ends at a whitespace or `end` and advance `it`.
+            Numbers with at most 19 significant digits and a decimal exponent in [-22,22] are
+            converted exactly with one multiplication/division by a power of ten (both operands are
+            exact doubles), all others (and nan, inf, hex) are converted by `std::strtod`.
+            @return false if the token is not a number. */
+        bool parseNumber(const char*& it, const char* end, double& value)
+        {
+            static const double powersOf10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+            const char* p   = it;
+            bool negative   = false;
+            bool exact      = true;
+            bool hasDigits  = false;
+            std::uint64_t m = 0;  // mantissa
+            int digits      = 0;  // significant digits in `m`
+            int exponent    = 0;  // decimal exponent of `m`
+
+            if(p != end && (*p == '-' || *p == '+'))
+            {
+                negative = *p == '-';
+                ++p;
+            }
+            for(; p != end && isDigit(*p); ++p)
+            {
+                hasDigits = true;
+                if(digits < 19)
+                {
+                    m = m * 10 + static_cast<unsigned int>(*p - '0');
+                    digits += (m != 0);
+                }
+                else
+                {
+                    exact = false;
+                    ++exponent;
+                }
+            }
+            if(p != end && *p == '.')
+            {
+                for(++p; p != end && isDigit(*p); ++p)
+                {
+                    hasDigits = true;
+                    if(digits < 19)
+                    {
+                        m = m * 10 + static_cast<unsigned int>(*p - '0');
+                        digits += (m != 0);
+                        --exponent;
+                    }
+                    else
+                    {
+                        exact = false;
+                    }
+                }
+            }
+            if(hasDigits && p != end && (*p == 'e' || *p == 'E'))
+            {
+                ++p;
+                bool negativeExp = false;
+                if(p != end && (*p == '-' || *p == '+'))
+                {
+                    negativeExp = *p == '-';
+                    ++p;
+                }
+                if(p == end || !isDigit(*p))
+                {
+                    return false;
+                }
+                int e = 0;
+                for(; p != end && isDigit(*p); ++p)
+                {
+                    e = std::min(e * 10 + (*p - '0'), 100000);
+                }
+                exponent += negativeExp ? -e : e;
+            }
+
+            if(hasDigits && (p == end || isSpace(*p) || *p == '\n'))
+            {
+                if(exact && m <= (std::uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+                {
+                    double v = static_cast<double>(m);
+                    v        = exponent < 0 ? v / powersOf10[-exponent] : v * powersOf10[exponent];
+                    value    = negative ? -v : v;
+                    it       = p;
+                    return true;
+                }
+            }
+
+            // Slow path over the whole token
+            const char* tokenEnd = it;
+            while(tokenEnd != end && !isSpace(*tokenEnd) && *tokenEnd != '\n')
+            {
+                ++tokenEnd;
+            }
+            std::string token(it, tokenEnd);
+            char* parsedEnd = nullptr;
+            value           = std::strtod(token.c_str(), &parsedEnd);
+            if(token.empty() || parsedEnd != token.c_str() + token.size())
+            {
+                return false;
+            }
+            it = tokenEnd;
+            return true;
+        }
+
+        /** Number of non-empty lines in [begin, end). */
+        std::size_t countPointLines(const char* begin, const char* end)
+        {
+            std::size_t lines = 0;
+            bool nonEmpty     = false;
+            for(const char* p = begin; p != end; ++p)
+            {
+                if(*p == '\n')
+                {
+                    lines += nonEmpty;
+                    nonEmpty = false;
+                }
+                else if(!isSpace(*p))
+                {
+                    nonEmpty = true;
+                }
+            }
+            return lines + nonEmpty;
+        }
+
+        /** Parse the non-empty lines in [begin, end) into the points starting at `out`.
+            @return nullptr or the start of the first invalid line. */
+        const char* parsePointLines(const char* begin, const char* end, PREC* out)
+        {
+            const char* p = begin;
+            while(p != end)
+            {
+                const char* line = p;
+                while(p != end && isSpace(*p))
+                {
+                    ++p;
+                }
+                if(p == end)
+                {
+                    break;
+                }
+                if(*p == '\n')
+                {
+                    ++p;
+                    continue;
+                }
+                for(unsigned int i = 0; i < 3; ++i)
+                {
+                    double v;
+                    if(!parseNumber(p, end, v))
+                    {
+                        return line;
+                    }
+                    *out++ = static_cast<PREC>(v);
+                    while(p != end && isSpace(*p))
+                    {
+                        ++p;
+                    }
+                }
+                if(p != end)
+                {
+                    if(*p != '\n')
+                    {
+                        return line;
+                    }
+                    ++p;
+                }
+            }
+            return nullptr;
+        }
+    }  // namespace details
+
+    MappedPointCloud::MappedPointCloud(MappedPointCloud&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedPointCloud& MappedPointCloud::operator=(MappedPointCloud&& other) noexcept
+    {
+        if(this != &other)
+        {
+            close();
+            m_header = other.m_header;
+            m_data   = other.m_data;
+            m_bytes  = other.m_bytes;
+#if(defined _WIN32) || (defined WIN32)
+            m_file          = other.m_file;
+            m_mapping       = other.m_mapping;
+            other.m_file    = nullptr;
+            other.m_mapping = nullptr;
+#endif
+            other.m_header = PointCloudFileHeader{};
+            other.m_data   = nullptr;
+            other.m_bytes  = 0;
+        }
+        return *this;
+    }
+
+    void MappedPointCloud::open(const std::string& filename)
+    {
+        close();
+
+#if(defined _WIN32) || (defined WIN32)
+        HANDLE file = CreateFileA(
+            filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(file == INVALID_HANDLE_VALUE)
+        {
+            ApproxMVBB_ERRORMSG("cannot open file: " << filename);
+        }
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            ApproxMVBB_ERRORMSG("cannot get size of file (or empty): " << filename);
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* data     = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if(data == nullptr)
+        {
+            if(mapping)
+            {
+                CloseHandle(mapping);
+            }
+            CloseHandle(file);
+            ApproxMVBB_ERRORMSG("cannot map file: " << filename);
+        }
+        m_file    = file;
+        m_mapping = mapping;
+        m_data    = data;
+        m_bytes   = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if(fd < 0)
+        {
+            ApproxMVBB_ERRORMSG("cannot open file: " << filename);
+        }
+        struct stat st;
+        if(fstat(fd, &st) != 0 || st.st_size == 0)
+        {
+            ::close(fd);
+            ApproxMVBB_ERRORMSG("cannot get size of file (or empty): " << filename);
+        }
+        void* data = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        // the mapping stays valid after closing the descriptor
+        ::close(fd);
+        if(data == MAP_FAILED)
+        {
+            ApproxMVBB_ERRORMSG("cannot map file: " << filename);
+        }
+        // the points are read once front to back
+        madvise(data, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+        m_data  = data;
+        m_bytes = static_cast<std::size_t>(st.st_size);
+#endif
+
+        // Validate the header
+        if(m_bytes < sizeof(PointCloudFileHeader))
+        {
+            close();
+            ApproxMVBB_ERRORMSG("file too small for a point cloud header: " << filename);
+        }
+        std::memcpy(&m_header, m_data, sizeof(PointCloudFileHeader));
+
+        const char* error = nullptr;
+        if(std::memcmp(m_header.m_magic, "AMVBBPTS", sizeof(m_header.m_magic)) != 0)
+        {
+            error = "not a point cloud file (wrong magic)";
+        }
+        else if(m_header.m_bigEndian != (details::isBigEndian() ? 1 : 0))
+        {
+            error = "file has not the native byte order";
+        }
+        else if(m_header.m_version != PointCloudFileHeader::currentVersion)
+        {
+            error = "unsupported file version";
+        }
+        else if(m_header.m_scalarBytes != sizeof(PREC))
+        {
+            error = "file has not the scalar type PREC";
+        }
+        else if(m_header.m_dataOffset < sizeof(PointCloudFileHeader) || m_header.m_dataOffset % sizeof(PREC) != 0)
+        {
+            error = "invalid data offset";
+        }
+        else if(m_header.m_dataOffset > m_bytes || m_header.m_dimension == 0 ||
+                (m_bytes - m_header.m_dataOffset) / (std::uint64_t(m_header.m_dimension) * sizeof(PREC)) <
+                    m_header.m_count)
+        {
+            error = "file too small for the number of points";
+        }
+
+        if(error)
+        {
+            PointCloudFileHeader h = m_header;
+            close();
+            ApproxMVBB_ERRORMSG(error << ": " << filename << " (bigEndian: " << int(h.m_bigEndian)
+                                      << ", scalar bytes: " << int(h.m_scalarBytes)
+                                      << ", dimension: " << h.m_dimension << ", count: " << h.m_count << ")");
+        }
+    }
+
+    void MappedPointCloud::close()
+    {
+        if(m_data)
+        {
+#if(defined _WIN32) || (defined WIN32)
+            UnmapViewOfFile(m_data);
+            CloseHandle(static_cast<HANDLE>(m_mapping));
+            CloseHandle(static_cast<HANDLE>(m_file));
+            m_file    = nullptr;
+            m_mapping = nullptr;
+#else
+            munmap(m_data, m_bytes);
+#endif
+        }
+        m_header = PointCloudFileHeader{};
+        m_data   = nullptr;
+        m_bytes  = 0;
+    }
+
+    void readPointCloudText(const std::string& filename, Matrix3Dyn& points, unsigned int nChunks)
+    {
+        std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+        if(!file.is_open())
+        {
+            ApproxMVBB_ERRORMSG("Could not open file: " << filename);
+        }
+        std::vector<char> buffer(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if(!file)
+        {
+            ApproxMVBB_ERRORMSG("Could not read file: " << filename);
+        }
+        const char* data  = buffer.data();
+        std::size_t bytes = buffer.size();
+
+        if(nChunks == 0)
+        {
+#if defined(ApproxMVBB_OPENMP_SUPPORT) && defined(ApproxMVBB_OPENMP_USE_NTHREADS)
+            nChunks = 4 * ApproxMVBB_OPENMP_NTHREADS;
+#elif defined(ApproxMVBB_OPENMP_SUPPORT) && defined(_OPENMP)
+            nChunks = 4 * static_cast<unsigned int>(omp_get_max_threads());
+#else
+            nChunks = 1;
+#endif
+            // Each chunk should have some lines
+            nChunks = static_cast<unsigned int>(std::min<std::size_t>(nChunks, bytes / (1 << 16)));
+        }
+        nChunks = std::max(nChunks, 1U);
+
+        // Chunk boundaries: each chunk starts after a line break
+        std::vector<const char*> chunks(nChunks + 1);
+        chunks[0]       = data;
+        chunks[nChunks] = data + bytes;
+        for(unsigned int c = 1; c < nChunks; ++c)
+        {
+            const char* p = std::max(data + bytes * c / nChunks, chunks[c - 1]);
+            while(p != data + bytes && p != data && *(p - 1) != '\n')
+            {
+                ++p;
+            }
+            chunks[c] = p;
+        }
+
+        // Count the points of each chunk and parse them at their offset into `points`
+        std::vector<std::size_t> offsets(nChunks + 1, 0);
+        std::vector<const char*> errors(nChunks, nullptr);
+        int n = static_cast<int>(nChunks);
+
+        // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+        #pragma omp parallel for schedule(dynamic, 1) ApproxMVBB_OPENMP_NUMTHREADS
+#endif
+        // clang-format on
+        for(int c = 0; c < n; ++c)
+        {
+            offsets[c + 1] = details::countPointLines(chunks[c], chunks[c + 1]);
+        }
+
+        for(unsigned int c = 0; c < nChunks; ++c)
+        {
+            offsets[c + 1] += offsets[c];
+        }
+        points.resize(3, static_cast<Matrix3Dyn::Index>(offsets[nChunks]));
+
+        // clang-format off
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+        #pragma omp parallel for schedule(dynamic, 1) ApproxMVBB_OPENMP_NUMTHREADS
+#endif
+        // clang-format on
+        for(int c = 0; c < n; ++c)
+        {
+            errors[c] = details::parsePointLines(chunks[c], chunks[c + 1], points.data() + 3 * offsets[c]);
+        }
+
+        for(auto* e : errors)
+        {
+            if(e)
+            {
+                const char* lineEnd = std::find(e, data + bytes, '\n');
+                ApproxMVBB_ERRORMSG("Could not parse line " << std::count(data, e, '\n') + 1 << " of file: "
+                                                            << filename << " : '" << std::string(e, lineEnd) << "'");
+            }
+        }
+    }
+}  // namespace ApproxMVBB
@@ -10,11 +10,183 @@
 #ifndef ApproxMVBB_ProjectedPointSet_cpp
 #define ApproxMVBB_ProjectedPointSet_cpp
 
+#include <algorithm>
+#include <array>
+
 #include "ApproxMVBB/ProjectedPointSet.hpp"
 
 namespace ApproxMVBB
 {
    ProjectedPointSet::ProjectedPointSet() = default;
    ProjectedPointSet::~ProjectedPointSet() = default;
+
+    void ProjectedPointSet::setupProjection()
+    {
+        using namespace CoordinateSystem;
+
+        // Generate Orthonormal Bases
+        Vector3 xDir, yDir;
+        // std::cout << "dir: " <<  m_zDir << std::endl;
+        makeCoordinateSystem(m_zDir, xDir, yDir);
+
+        // Make coodinate transform from coordinate system `I`  to K!
+        m_A_KI.col(0) = xDir;
+        m_A_KI.col(1) = yDir;
+        m_A_KI.col(2) = m_zDir;
+        m_A_KI.transposeInPlace();
+        ApproxMVBB_ASSERTMSG(
+            checkOrthogonality(xDir, yDir, m_zDir, 1e-6),
+            "Not orthogonal: x:" << xDir.transpose() << " y: " << yDir.transpose() << " z: " << m_zDir.transpose());
+    }
+
+    OOBB ProjectedPointSet::computeMVBBOfProjection()
+    {
+        // compute minimum area rectangle first
+        // std::cout << "Dump points DEBUG:" << std::endl;
+        // TestFunctions::dumpPointsMatrixBinary("DumpedPoints.bin",m_p);
+
+        MinAreaRectangle mar(m_p.leftCols(m_nPoints), m_rectBuffers);
+#ifdef ApproxMVBB_OPENMP_SUPPORT
+        // The convex hull dominates for large point sets
+        mar.compute(m_nPoints >= m_parallelHullMinPoints ? ConvexHull2D::Algorithm::ParallelMonotoneChain :
+                                                           ConvexHull2D::Algorithm::GrahamScan);
+#else
+        mar.compute();
+#endif
+        auto rect = mar.getMinRectangle();
+
+        // std::cout << "Dump RECT DEBUG:" << std::endl;
+        // Vector2List p;
+        // p.push_back( rect.m_p);
+        // p.push_back( rect.m_p + rect.m_u );
+        // p.push_back( rect.m_p + rect.m_u + rect.m_v );
+        // p.push_back( rect.m_p + rect.m_v );
+        // p.push_back( rect.m_p);
+
+        // TestFunctions::dumpPoints("./MinAreaRectangleTest13" "Out.txt",p);
+
+        // Box coordinates are in K Frame
+
+        Matrix22 A2_KM;
+
+        //        std::cout << "u:" << rect.m_u.norm() << std::endl;
+        //        std::cout << "v:" << rect.m_v.norm() << std::endl;
+
+        A2_KM.col(0) = rect.m_u;
+        A2_KM.col(1) = rect.m_v;
+
+        Vector2 M_p = A2_KM.transpose() * rect.m_p;
+
+        Vector3 M_min;
+        M_min.head<2>() = M_p;
+        M_min(2)        = m_minZValue;
+
+        Vector3 M_max(rect.m_uL, rect.m_vL, 0.0);
+        M_max.head<2>() += M_p;
+        M_max(2) = m_maxZValue;
+
+        // Make coordinate transformation from `M` coordinate system (Minimum Rectancle)
+        // to `K` coordinate system (Projection Plane);
+        Matrix33 A_IM;
+        // Make A_KM
+        A_IM.setIdentity();
+        A_IM.block<2, 2>(0, 0) = A2_KM;
+        // Make A_IM;
+        A_IM = m_A_KI.transpose() * A_IM;  // A_IM = A_IK * A_KM
+
+        return OOBB(M_min, M_max, A_IM);
+    }
+
+    ProjectedPointSet::Matrix2Dyn::Index ProjectedPointSet::discardInteriorPoints(Matrix2Dyn::Index nPoints)
+    {
+        using namespace PointFunctions;
+        using IndexType = Matrix2Dyn::Index;
+
+        if(nPoints < 9)
+        {
+            return nPoints;
+        }
+
+        // Extreme points in the directions (counter-clockwise):
+        // (1,0), (1,1), (0,1), (-1,1), (-1,0), (-1,-1), (0,-1), (1,-1)
+        // which form a convex polygon (counter-clockwise) inside the convex hull
+        std::array<IndexType, 8> extIdx;
+        extIdx.fill(0);
+        std::array<PREC, 8> extVal;
+        extVal.fill(std::numeric_limits<PREC>::lowest());
+        for(IndexType i = 0; i < nPoints; ++i)
+        {
+            const PREC x                  = m_p(0, i);
+            const PREC y                  = m_p(1, i);
+            const std::array<PREC, 8> val = {{x, x + y, y, y - x, -x, -x - y, -y, x - y}};
+            for(unsigned int k = 0; k < 8; ++k)
+            {
+                if(val[k] > extVal[k])
+                {
+                    extVal[k] = val[k];
+                    extIdx[k] = i;
+                }
+            }
+        }
+
+        // Edges of the octagon (skip degenerate edges)
+        std::array<std::pair<IndexType, IndexType>, 8> edges;
+        unsigned int nEdges = 0;
+        for(unsigned int k = 0; k < 8; ++k)
+        {
+            IndexType a = extIdx[k];
+            IndexType b = extIdx[(k + 1) % 8];
+            if(a != b && m_p.col(a) != m_p.col(b))
+            {
+                edges[nEdges++] = {a, b};
+            }
+        }
+
+        // A polygon with less than three edges has no interior
+        if(nEdges < 3)
+        {
+            return nPoints;
+        }
+
+        // Keep all points which are not strictly inside (strictly left of all edges)
+        IndexType k = 0;
+        for(IndexType i = 0; i < nPoints; ++i)
+        {
+            bool inside = true;
+            for(unsigned int e = 0; e < nEdges && inside; ++e)
+            {
+                inside = orient2d(m_p.col(edges[e].first), m_p.col(edges[e].second), m_p.col(i)) > 0;
+            }
+            if(!inside)
+            {
+                if(k != i)
+                {
+                    m_p.col(k) = m_p.col(i);
+                }
+                ++k;
+            }
+        }
+        return k;
+    }
+
+    ProjectedPointSet::Matrix2Dyn::Index ProjectedPointSet::reduceToConvexHull(Matrix2Dyn::Index nPoints)
+    {
+        ConvexHull2D hull(m_p.leftCols(nPoints), m_rectBuffers.m_convexHull);
+        hull.computeMonotonChain();
+
+        // Move the hull vertices to the front (ascending, such that no vertex is overwritten)
+        std::vector<unsigned int>& indices = hull.getIndices();
+        std::sort(indices.begin(), indices.end());
+        Matrix2Dyn::Index k = 0;
+        for(unsigned int i : indices)
+        {
+            if(k != i)
+            {
+                m_p.col(k) = m_p.col(i);
+            }
+            ++k;
+        }
+        return k;
+    }
 }  // namespace ApproxMVBB
 #endif
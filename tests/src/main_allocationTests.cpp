@@ -0,0 +1,204 @@
+// ========================================================================================
+//  ApproxMVBB
+//  Copyright (C) 2014 by Gabriel Nützi <nuetzig (at) imes (d0t) mavt (d0t) ethz (døt) ch>
+//
+//  This Source Code Form is subject to the terms of the Mozilla Public
+//  License, v. 2.0. If a copy of the MPL was not distributed with this
+//  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// ========================================================================================
+
+#include <cstdlib>
+#include <iostream>
+
+#include "TestConfig.hpp"
+
+#include "ApproxMVBB/ComputeApproxMVBB.hpp"
+
+#include "TestFunctions.hpp"
+
+// Count all heap allocations (operator new, Eigen and the diameter estimator all end up in malloc)
+// by replacing malloc/calloc/realloc of glibc in this executable.
+#if defined(__GLIBC__)
+#    define ApproxMVBB_TESTS_COUNT_ALLOCATIONS
+namespace
+{
+    bool g_countAllocations    = false;
+    std::size_t g_nAllocations = 0;
+}  // namespace
+
+extern "C"
+{
+    void* __libc_malloc(std::size_t size);
+    void* __libc_calloc(std::size_t n, std::size_t size);
+    void* __libc_realloc(void* p, std::size_t size);
+
+    void* malloc(std::size_t size) noexcept
+    {
+        g_nAllocations += g_countAllocations;
+        return __libc_malloc(size);
+    }
+    void* calloc(std::size_t n, std::size_t size) noexcept
+    {
+        g_nAllocations += g_countAllocations;
+        return __libc_calloc(n, size);
+    }
+    void* realloc(void* p, std::size_t size) noexcept
+    {
+        g_nAllocations += g_countAllocations;
+        return __libc_realloc(p, size);
+    }
+}
+#endif
+
+namespace ApproxMVBB
+{
+    namespace AllocationTests
+    {
+        /** Returns the number of allocations done by `f` */
+        template<typename Func>
+        std::size_t countAllocations(Func&& f)
+        {
+#ifdef ApproxMVBB_TESTS_COUNT_ALLOCATIONS
+            g_nAllocations     = 0;
+            g_countAllocations = true;
+            f();
+            g_countAllocations = false;
+            return g_nAllocations;
+#else
+            f();
+            return 0;
+#endif
+        }
+
+        template<typename TMatrix>
+        Matrix3Dyn fromFile(const TMatrix& v)
+        {
+            Matrix3Dyn t(3, v.size());
+            for(unsigned int i = 0; i < v.size(); ++i)
+            {
+                t.col(i) = v[i];
+            }
+            return t;
+        }
+    }  // namespace AllocationTests
+}  // namespace ApproxMVBB
+
+using namespace ApproxMVBB;
+using namespace ApproxMVBB::AllocationTests;
+
+MY_TEST(AllocationTest, Workspace)
+{
+    MY_TEST_RANDOM_STUFF(AllocationTest, Workspace);
+    auto f = [&](PREC) { return uni(rng); };
+
+    Matrix3Dyn t(3, 10000);
+    t = t.unaryExpr(f);
+
+    MVBBWorkspace workspace;
+    OOBB oobb;
+    auto first = approximateMVBB(t, workspace, 0.001, 400, 5, 2, 6);
+
+    auto n = countAllocations([&]() {
+        for(int i = 0; i < 3; ++i)
+        {
+            oobb = approximateMVBB(t, workspace, 0.001, 400, 5, 2, 6);
+        }
+    });
+    ASSERT_EQ(n, 0u) << "Allocations in steady state: " << n;
+
+    // Same result as without workspace
+    auto oobbNoWorkspace = approximateMVBB(t, 0.001, 400, 5, 2, 6);
+    ASSERT_TRUE(tf::assertNearArray(oobb.m_minPoint, oobbNoWorkspace.m_minPoint, 1e-10));
+    ASSERT_TRUE(tf::assertNearArray(oobb.m_maxPoint, oobbNoWorkspace.m_maxPoint, 1e-10));
+    ASSERT_TRUE(tf::assertNearArray(oobb.m_q_KI.coeffs(), oobbNoWorkspace.m_q_KI.coeffs(), 1e-10));
+    ASSERT_TRUE((oobb.m_minPoint.array() == first.m_minPoint.array()).all());
+    ASSERT_TRUE((oobb.m_maxPoint.array() == first.m_maxPoint.array()).all());
+}
+
+MY_TEST(AllocationTest, WorkspaceDifferentSizes)
+{
+    MY_TEST_RANDOM_STUFF(AllocationTest, WorkspaceDifferentSizes);
+    auto f = [&](PREC) { return uni(rng); };
+
+    std::vector<Matrix3Dyn> sets;
+    for(unsigned int k = 0; k < 4; k++)
+    {
+        auto t = fromFile(tf::getPointsFromFile3D(tf::getFileInPath("PointCloud_" + std::to_string(k) + ".txt")));
+        pf::applyRandomRotTrans(t, f);
+        sets.push_back(t);
+    }
+    for(unsigned int n : {3, 200, 5000})
+    {
+        Matrix3Dyn t(3, n);
+        sets.push_back(t.unaryExpr(f));
+    }
+
+    // Warm up: the buffers grow to the largest point cloud
+    MVBBWorkspace workspace;
+    for(auto& t : sets)
+    {
+        approximateMVBB(t, workspace, 0.1, 400, 5, 3, 6);
+    }
+
+    auto n = countAllocations([&]() {
+        for(auto& t : sets)
+        {
+            approximateMVBB(t, workspace, 0.1, 400, 5, 3, 6);
+        }
+    });
+    ASSERT_EQ(n, 0u) << "Allocations in steady state: " << n;
+}
+
+MY_TEST(AllocationTest, WorkspaceSampleGridModes)
+{
+    MY_TEST_RANDOM_STUFF(AllocationTest, WorkspaceSampleGridModes);
+    auto f = [&](PREC) { return uni(rng); };
+
+    Matrix3Dyn t(3, 10000);
+    t = t.unaryExpr(f);
+    t.row(0) *= 10;
+
+    for(auto mode : {SampleGridMode::Square, SampleGridMode::Anisotropic, SampleGridMode::SixFaces})
+    {
+        MVBBWorkspace workspace;
+        approximateMVBB(t, workspace, 0.001, 400, 5, 2, 6, seed, false, mode);
+
+        auto n = countAllocations([&]() { approximateMVBB(t, workspace, 0.001, 400, 5, 2, 6, seed, false, mode); });
+        ASSERT_EQ(n, 0u) << "Allocations in steady state: " << n << " mode: " << static_cast<int>(mode);
+    }
+}
+
+MY_TEST(AllocationTest, WorkspaceSamplePadding)
+{
+    MY_TEST_RANDOM_STUFF(AllocationTest, WorkspaceSamplePadding);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // Flat points: most cells of the square grid (over the two smaller extents) stay empty
+    // and the sample is padded
+    Matrix3Dyn t(3, 10000);
+    t = t.unaryExpr(f);
+    t.row(0) *= 100;
+    t.row(1) *= 50;
+
+    for(auto padding : {SamplePadding::Random,
+                        SamplePadding::StratifiedReservoir,
+                        SamplePadding::PoissonDisk,
+                        SamplePadding::FarthestPoint})
+    {
+        MVBBWorkspace workspace;
+        auto first = approximateMVBB(t, workspace, 0.001, 400, 5, 2, 6, seed, false, SampleGridMode::Square, padding);
+
+        OOBB oobb;
+        auto n = countAllocations([&]() {
+            oobb = approximateMVBB(t, workspace, 0.001, 400, 5, 2, 6, seed, false, SampleGridMode::Square, padding);
+        });
+        ASSERT_EQ(n, 0u) << "Allocations in steady state: " << n << " padding: " << static_cast<int>(padding);
+        ASSERT_EQ(oobb.volume(), first.volume()) << "padding: " << static_cast<int>(padding);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
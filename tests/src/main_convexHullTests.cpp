@@ -15,6 +15,7 @@
 #include "TestConfig.hpp"
 
 #include "ApproxMVBB/ComputeApproxMVBB.hpp"
+#include "ApproxMVBB/ConvexHull3D.hpp"
 
 #include "CPUTimer.hpp"
 #include "TestFunctions.hpp"
@@ -23,6 +24,58 @@ namespace ApproxMVBB
 {
     namespace ConvexHullTest
     {
+        /** Signed area of the polygon `p` (counter-clockwise > 0) */
+        template<typename TMatrix>
+        PREC polygonArea(const TMatrix& p)
+        {
+            PREC a = 0;
+            for(decltype(p.cols()) i = 0; i < p.cols(); ++i)
+            {
+                auto j = (i + 1) % p.cols();
+                a += p(0, i) * p(1, j) - p(0, j) * p(1, i);
+            }
+            return 0.5 * a;
+        }
+
+        /** All other algorithms produce the same hull as the Graham scan `qHull` */
+        template<typename TMatrix>
+        void compareAlgorithms(const TMatrix& v, const Matrix2Dyn& qHull)
+        {
+            namespace tf = TestFunctions;
+            for(auto algorithm : {ConvexHull2D::Algorithm::MonotoneChain,
+                                  ConvexHull2D::Algorithm::QuickHull,
+                                  ConvexHull2D::Algorithm::ParallelMonotoneChain})
+            {
+                ConvexHull2D c(v);
+                c.compute(algorithm);
+                EXPECT_TRUE(c.verifyHull()) << "Algorithm: " << static_cast<int>(algorithm);
+
+                auto& ind = c.getIndices();
+                ApproxMVBB::Matrix2Dyn qHull2(2, ind.size());
+                unsigned int j = 0;
+                for(auto& i : ind)
+                {
+                    qHull2.col(j++) = v.col(i);
+                }
+
+                // On nearly degenerate inputs (almost equal points) the hulls may differ in
+                // ulp-close vertices, the enclosed polygon is the same
+                EXPECT_NEAR(polygonArea(qHull2), polygonArea(qHull), 1e-10 * (1.0 + std::abs(polygonArea(qHull))))
+                    << "Algorithm: " << static_cast<int>(algorithm);
+                EXPECT_TRUE(tf::assertNearArray(qHull2.col(0), qHull.col(0))) << "Algorithm: " << static_cast<int>(algorithm);
+            }
+
+            // The parallel hull is identical to the serial monotone chain for any number of blocks
+            ConvexHull2D serial(v);
+            serial.computeMonotonChain();
+            for(unsigned int nBlocks : {1, 2, 3, 7, 64})
+            {
+                ConvexHull2D c(v);
+                c.computeParallel(nBlocks);
+                EXPECT_EQ(c.getIndices(), serial.getIndices()) << "Blocks: " << nBlocks;
+            }
+        }
+
         template<typename TMatrix>
         void convexHullTest(std::string name, const TMatrix& v, bool dumpPoints = true)
         {
@@ -62,6 +115,8 @@ namespace ApproxMVBB
             valid.setConstant(std::numeric_limits<PREC>::signaling_NaN());
             tf::readPointsMatrixBinary(tf::getFileValidationPath(name), valid);
             EXPECT_TRUE(tf::assertNearArray(qHull, valid));
+
+            compareAlgorithms(v, qHull);
         }
 
         //    void MY_TEST() {
@@ -254,6 +309,156 @@ MY_TEST(ConvexHullTest, PointsBadProjection6)
     convexHullTest(testName, t);
 }
 
+MY_TEST(ConvexHullTest, AlgorithmsPointClouds)
+{
+    MY_TEST_RANDOM_STUFF(ConvexHullTest, AlgorithmsPointClouds);
+    auto f = [&](PREC) { return uni(rng); };
+
+    std::vector<Matrix2Dyn> sets;
+    for(unsigned int k = 0; k < 4; k++)
+    {
+        auto v = tf::getPointsFromFile3D(tf::getFileInPath("PointCloud_" + std::to_string(k) + ".txt"));
+        Matrix3Dyn t(3, v.size());
+        for(unsigned int i = 0; i < v.size(); ++i)
+        {
+            t.col(i) = v[i];
+        }
+        pf::applyRandomRotTrans(t, f);
+        sets.emplace_back(t.topRows<2>());
+    }
+    Matrix2Dyn t(2, 100000);
+    sets.emplace_back(t.unaryExpr(f));
+    // Many equal and collinear points
+    sets.emplace_back(t.unaryExpr([&](PREC) { return std::floor(uni(rng) * 10); }));
+
+    for(auto& v : sets)
+    {
+        ConvexHull2D c(v);
+        c.compute();
+        ASSERT_TRUE(c.verifyHull());
+
+        auto& ind = c.getIndices();
+        Matrix2Dyn qHull(2, ind.size());
+        unsigned int j = 0;
+        for(auto& i : ind)
+        {
+            qHull.col(j++) = v.col(i);
+        }
+        compareAlgorithms(v, qHull);
+    }
+}
+
+MY_TEST(ConvexHullTest, Hull3D)
+{
+    MY_TEST_RANDOM_STUFF(ConvexHullTest, Hull3D);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // Random points and points on a sphere (all on the hull)
+    Matrix3Dyn t(3, 100000);
+    t = t.unaryExpr(f);
+    Matrix3Dyn s(3, 2000);
+    s = s.unaryExpr(f).array() - 0.5;
+    s.colwise().normalize();
+    s.row(0) *= 3.0;
+
+    for(auto* v : {&t, &s})
+    {
+        ConvexHull3D c(*v);
+        c.compute();
+        ASSERT_TRUE(c.verifyHull());
+        // Euler: F = 2V - 4 for a triangulated closed surface
+        ASSERT_EQ(c.getFaces().size(), 2 * c.getVertexIndices().size() - 4);
+        if(v == &s)
+        {
+            ASSERT_EQ(c.getVertexIndices().size(), s.cols());
+        }
+
+        // The box of the hull vertices is the box of all points
+        Matrix3Dyn vertices;
+        c.getVertices(vertices);
+        ASSERT_TRUE(tf::assertNearArray(vertices.rowwise().minCoeff(), v->rowwise().minCoeff(), 1e-12));
+        ASSERT_TRUE(tf::assertNearArray(vertices.rowwise().maxCoeff(), v->rowwise().maxCoeff(), 1e-12));
+    }
+
+    // Cube corners with equal and interior points
+    Matrix3Dyn cube(3, 8 + 8 + 1000);
+    for(unsigned int i = 0; i < 16; ++i)
+    {
+        cube.col(i) = Vector3((i & 1) ? 1 : 0, (i & 2) ? 1 : 0, (i & 4) ? 1 : 0);
+    }
+    cube.rightCols(1000) = cube.rightCols(1000).unaryExpr(f) * 0.5;
+    cube.rightCols(1000).array() += 0.25;
+    ConvexHull3D c(cube);
+    c.compute();
+    ASSERT_TRUE(c.verifyHull());
+    ASSERT_EQ(c.getVertexIndices().size(), 8u);
+}
+
+MY_TEST(ConvexHullTest, Hull3DNearlyCoplanar)
+{
+    MY_TEST_RANDOM_STUFF(ConvexHullTest, Hull3DNearlyCoplanar);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // Points close to a plane: thin slabs are hulled in 3d, thinner ones in the plane
+    for(PREC noise : {1e-6, 1e-10, 1e-13})
+    {
+        Matrix3Dyn t(3, 20000);
+        t = t.unaryExpr(f);
+        t.row(2) *= noise;
+        pf::applyRandomRotTrans(t, f);
+
+        ConvexHull3D c(t);
+        c.compute();
+        if(noise > 1e-8)
+        {
+            ASSERT_EQ(c.getFaces().size(), 2 * c.getVertexIndices().size() - 4);
+        }
+        else
+        {
+            ASSERT_TRUE(c.getFaces().empty());
+        }
+
+        // The box of the hull vertices is the box of all points
+        Matrix3Dyn vertices;
+        c.getVertices(vertices);
+        ASSERT_TRUE(tf::assertNearArray(vertices.rowwise().minCoeff(), t.rowwise().minCoeff(), 1e-12));
+        ASSERT_TRUE(tf::assertNearArray(vertices.rowwise().maxCoeff(), t.rowwise().maxCoeff(), 1e-12));
+    }
+}
+
+MY_TEST(ConvexHullTest, Hull3DDegenerate)
+{
+    MY_TEST_RANDOM_STUFF(ConvexHullTest, Hull3DDegenerate);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // Point
+    Matrix3Dyn p = Matrix3Dyn::Ones(3, 10);
+    ConvexHull3D c1(p);
+    c1.compute();
+    ASSERT_EQ(c1.getVertexIndices().size(), 1u);
+
+    // Line
+    Matrix3Dyn l(3, 100);
+    for(unsigned int i = 0; i < l.cols(); ++i)
+    {
+        l.col(i) = Vector3(1, 2, 3) * f(0);
+    }
+    ConvexHull3D c2(l);
+    c2.compute();
+    ASSERT_EQ(c2.getVertexIndices().size(), 2u);
+
+    // Square in a plane
+    Matrix3Dyn q(3, 104);
+    q.leftCols(100) = q.leftCols(100).unaryExpr(f);
+    q.rightCols(4) << 0, 1, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0;
+    q.row(2).setZero();
+    pf::applyRandomRotTrans(q, f);
+    ConvexHull3D c3(q);
+    c3.compute();
+    ASSERT_TRUE(c3.getFaces().empty());
+    ASSERT_EQ(c3.getVertexIndices(), (std::vector<unsigned int>{100, 101, 102, 103}));
+}
+
 #ifdef ApproxMVBB_TESTS_HIGH_PERFORMANCE
 MY_TEST(ConvexHullTest, PointsRandom14M)
 {
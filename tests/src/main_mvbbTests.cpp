@@ -15,10 +15,17 @@
 #include "TestConfig.hpp"
 
 #include "ApproxMVBB/ComputeApproxMVBB.hpp"
+#include "ApproxMVBB/ExactMVBB.hpp"
+#include "ApproxMVBB/IncrementalMVBB.hpp"
+#include "ApproxMVBB/PointCloudFile.hpp"
 
 #include "CPUTimer.hpp"
 #include "TestFunctions.hpp"
 
+#if defined(ApproxMVBB_OPENMP_SUPPORT) && defined(_OPENMP)
+#    include <omp.h>
+#endif
+
 namespace ApproxMVBB
 {
     namespace MVBBTests
@@ -257,6 +264,998 @@ MY_TEST(MVBBTest, PointClouds)
     }
 }
 
+MY_TEST(MVBBTest, ProjectStreaming)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, ProjectStreaming);
+    auto f = [&](PREC) { return uni(rng); };
+
+    std::vector<Matrix3Dyn> sets;
+    for(unsigned int k = 0; k < 10; k++)
+    {
+        auto v = tf::getPointsFromFile3D(tf::getFileInPath("PointCloud_" + std::to_string(k) + ".txt"));
+        Matrix3Dyn t(3, v.size());
+        for(unsigned int i = 0; i < v.size(); ++i)
+        {
+            t.col(i) = v[i];
+        }
+        pf::applyRandomRotTrans(t, f);
+        sets.push_back(t);
+    }
+    for(unsigned int n : {1, 2, 5, 20, 100000})
+    {
+        Matrix3Dyn t(3, n);
+        sets.push_back(t.unaryExpr(f));
+    }
+    // points in a plane and on a line
+    Matrix3Dyn t(3, 1000);
+    t = t.unaryExpr(f);
+    t.row(2).setZero();
+    sets.push_back(t);
+    t.row(1).setZero();
+    sets.push_back(t);
+
+    ProjectedPointSet proj;
+    for(std::size_t i = 0; i < sets.size(); ++i)
+    {
+        for(unsigned int k = 0; k < 3; ++k)
+        {
+            Vector3 dir = Vector3(uni(rng), uni(rng), uni(rng)) - Vector3(0.5, 0.5, 0.5);
+            auto oobb   = proj.computeMVBB(dir, sets[i]);
+
+            for(int chunkSize : {1, 7, 100, 1 << 16})
+            {
+                auto o = proj.computeMVBBStreaming(dir, sets[i], chunkSize);
+                ASSERT_TRUE(tf::assertNearArray(o.m_minPoint, oobb.m_minPoint, 1e-10)) << "Set: " << i;
+                ASSERT_TRUE(tf::assertNearArray(o.m_maxPoint, oobb.m_maxPoint, 1e-10)) << "Set: " << i;
+                ASSERT_NEAR(o.volume(), oobb.volume(), 1e-10) << "Set: " << i;
+            }
+        }
+    }
+
+    // Points in a ball: the octagon filter keeps a fixed fraction of them,
+    // the candidates need to stay near the size of the convex hull
+    Matrix3Dyn ball(3, 500000);
+    for(unsigned int i = 0; i < ball.cols(); ++i)
+    {
+        Vector3 p   = Vector3(uni(rng), uni(rng), uni(rng)) - Vector3(0.5, 0.5, 0.5);
+        ball.col(i) = p.normalized() * std::cbrt(uni(rng));
+    }
+    const Matrix3Dyn::Index chunkSize = 1 << 14;
+    Vector3 dir(1, 2, 3);
+    proj.beginMVBBStreaming(dir);
+    for(Matrix3Dyn::Index first = 0; first < ball.cols(); first += chunkSize)
+    {
+        proj.addMVBBStreaming(ball.middleCols(first, std::min(chunkSize, ball.cols() - first)));
+        ASSERT_LE(proj.getNumberOfCandidates(), 2 * chunkSize);
+    }
+    auto o    = proj.endMVBBStreaming();
+    auto oobb = proj.computeMVBB(dir, ball);
+    ASSERT_TRUE(tf::assertNearArray(o.m_minPoint, oobb.m_minPoint, 1e-10));
+    ASSERT_TRUE(tf::assertNearArray(o.m_maxPoint, oobb.m_maxPoint, 1e-10));
+}
+
+MY_TEST(MVBBTest, OptimizeParallel)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, OptimizeParallel);
+    auto f = [&](PREC) { return uni(rng); };
+
+    std::vector<Matrix3Dyn> sets;
+    for(unsigned int k = 0; k < 10; k++)
+    {
+        auto v = tf::getPointsFromFile3D(tf::getFileInPath("PointCloud_" + std::to_string(k) + ".txt"));
+        Matrix3Dyn t(3, v.size());
+        for(unsigned int i = 0; i < v.size(); ++i)
+        {
+            t.col(i) = v[i];
+        }
+        pf::applyRandomRotTrans(t, f);
+        sets.push_back(t);
+    }
+    Matrix3Dyn t(3, 10000);
+    sets.push_back(t.unaryExpr(f));
+
+    for(std::size_t i = 0; i < sets.size(); ++i)
+    {
+        // start from the diameter box without optimization
+        auto start = approximateMVBBDiam(sets[i], 0.1, 0, seed);
+        auto oobb  = optimizeMVBB(sets[i], start, 20);
+
+        // the speculative loops need to replay the serial loop exactly
+        for(unsigned int nSpeculative : {1, 2, 3, 4, 7, 20, 30})
+        {
+            auto o = optimizeMVBBParallel(sets[i], start, 20, 1e-6, 1e-12, nSpeculative);
+            ASSERT_TRUE((o.m_minPoint.array() == oobb.m_minPoint.array()).all()) << "Set: " << i;
+            ASSERT_TRUE((o.m_maxPoint.array() == oobb.m_maxPoint.array()).all()) << "Set: " << i;
+            ASSERT_TRUE((o.m_q_KI.coeffs().array() == oobb.m_q_KI.coeffs().array()).all()) << "Set: " << i;
+        }
+
+        // memory cap of the projections (one loop at a time) and the opt-in of approximateMVBBDiam
+        for(auto o : {optimizeMVBBParallel(sets[i], start, 20, 1e-6, 1e-12, 8, 1),
+                      approximateMVBBDiam(sets[i], 0.1, 20, seed, true)})
+        {
+            ASSERT_TRUE((o.m_minPoint.array() == oobb.m_minPoint.array()).all()) << "Set: " << i;
+            ASSERT_TRUE((o.m_maxPoint.array() == oobb.m_maxPoint.array()).all()) << "Set: " << i;
+            ASSERT_TRUE((o.m_q_KI.coeffs().array() == oobb.m_q_KI.coeffs().array()).all()) << "Set: " << i;
+        }
+    }
+}
+
+MY_TEST(MVBBTest, SampleGridChunks)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, SampleGridChunks);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // Coarse coordinates: many points with equal z in a cell
+    Matrix3Dyn t(3, 100000);
+    t = t.unaryExpr([&](PREC) { return std::round(100 * uni(rng)) / 100; });
+    pf::applyRandomRotTrans(t, f);
+
+    OOBB oobb = approximateMVBBDiam(t, 0.1, 0, seed);
+    oobb.setZAxisLongest();
+
+    for(auto mode : {SampleGridMode::Square, SampleGridMode::SixFaces})
+    {
+        std::array<details::SampleGridLayout, 3> layouts;
+        unsigned int nLayouts = 0;
+        std::size_t nCells    = details::makeSampleGridLayouts(layouts, nLayouts, 200, oobb, mode);
+
+        std::vector<details::BottomTopPoints> serial(nCells);
+        details::addToSampleGrid(t, 0, t.cols(), oobb, layouts, nLayouts, serial.data());
+
+        // The merged grids of the chunks need to be the serial grid
+        for(long long int nChunks : {2, 3, 7, 16})
+        {
+            std::vector<details::BottomTopPoints> grids(nChunks * nCells);
+            for(long long int c = nChunks - 1; c >= 0; --c)
+            {
+                details::addToSampleGrid(t,
+                                         c * t.cols() / nChunks,
+                                         (c + 1) * t.cols() / nChunks,
+                                         oobb,
+                                         layouts,
+                                         nLayouts,
+                                         &grids[c * nCells]);
+            }
+            for(long long int c = 1; c < nChunks; ++c)
+            {
+                for(std::size_t i = 0; i < nCells; ++i)
+                {
+                    details::mergeSampleGridCells(grids[i], grids[c * nCells + i]);
+                }
+            }
+            for(std::size_t i = 0; i < nCells; ++i)
+            {
+                ASSERT_EQ(grids[i].topIdx, serial[i].topIdx) << "chunks: " << nChunks << " cell: " << i;
+                ASSERT_EQ(grids[i].bottomIdx, serial[i].bottomIdx) << "chunks: " << nChunks << " cell: " << i;
+            }
+        }
+    }
+}
+
+MY_TEST(MVBBTest, SampleGridModes)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, SampleGridModes);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // Elongated body
+    Matrix3Dyn t(3, 100000);
+    t = t.unaryExpr(f);
+    t.row(0) *= 20.0;
+    t.row(1) *= 2.0;
+
+    // Anisotropic cells: about 2 points per cell and no empty cells
+    OOBB oobb(t.rowwise().minCoeff(), t.rowwise().maxCoeff(), Matrix33::Identity());
+    oobb.setZAxisLongest();
+    std::array<details::SampleGridLayout, 3> layouts;
+    unsigned int nLayouts = 0;
+    auto nCells = details::makeSampleGridLayouts(layouts, nLayouts, 100, oobb, SampleGridMode::Anisotropic);
+    ASSERT_EQ(nLayouts, 1u);
+    ASSERT_LE(nCells, 50u);
+    ASSERT_GE(nCells, 40u);
+    std::vector<details::BottomTopPoints> grid(nCells);
+    details::addToSampleGrid(t, 0, t.cols(), oobb, layouts, nLayouts, grid.data());
+    for(auto& cell : grid)
+    {
+        ASSERT_NE(cell.bottomIdx, 0);
+    }
+
+    // The sample of SixFaces contains the extreme points in all axes of the box
+    pf::applyRandomRotTrans(t, f);
+    Matrix3Dyn sampled;
+    oobb = approximateMVBBDiam(t, 0.001, 0, seed);
+    samplePointsGrid(sampled, t, 100, oobb, seed, SampleGridMode::SixFaces);
+    ASSERT_EQ(sampled.cols(), 100);
+    Matrix33 A_KI = oobb.m_q_KI.matrix().transpose();
+    OOBB sampleBox(A_KI * sampled.col(0), A_KI * sampled.col(0), Matrix33::Identity());
+    OOBB pointsBox = sampleBox;
+    for(unsigned int i = 0; i < sampled.cols(); ++i)
+    {
+        sampleBox.unite(A_KI * sampled.col(i));
+    }
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        pointsBox.unite(A_KI * t.col(i));
+    }
+    ASSERT_TRUE((sampleBox.m_minPoint.array() == pointsBox.m_minPoint.array()).all());
+    ASSERT_TRUE((sampleBox.m_maxPoint.array() == pointsBox.m_maxPoint.array()).all());
+
+    // All modes give a similar box
+    auto reference = approximateMVBB(t, 0.001, 400, 5, 0, 6);
+    for(auto mode : {SampleGridMode::Anisotropic, SampleGridMode::SixFaces})
+    {
+        auto o = approximateMVBB(t, 0.001, 100, 5, 0, 6, seed, false, mode);
+        ASSERT_LE(o.volume(), 1.1 * reference.volume());
+    }
+}
+
+MY_TEST(MVBBTest, SamplePadding)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, SamplePadding);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // Skewed density in a wedge: many grid cells are empty or sparse
+    Matrix3Dyn t(3, 50000);
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        Vector3 p(f(0), f(0), f(0));
+        t.col(i) = Vector3(4 * p(0) * p(0) * p(0), 2 * p(1), p(2) * p(0));
+    }
+    pf::applyRandomRotTrans(t, f);
+    auto reference = approximateMVBB(t, 0.001, 400, 5, 0, 6);
+
+    for(auto padding : {SamplePadding::Random,
+                        SamplePadding::StratifiedReservoir,
+                        SamplePadding::PoissonDisk,
+                        SamplePadding::FarthestPoint})
+    {
+        OOBB oobb1 = approximateMVBBDiam(t, 0.001, 0, seed);
+        OOBB oobb2 = oobb1;
+        Matrix3Dyn sampled1, sampled2;
+        samplePointsGrid(sampled1, t, 200, oobb1, seed, SampleGridMode::Square, padding);
+        samplePointsGrid(sampled2, t, 200, oobb2, seed, SampleGridMode::Square, padding);
+        ASSERT_EQ(sampled1.cols(), 200);
+        ASSERT_TRUE((sampled1.array() == sampled2.array()).all());
+
+        // No point twice (besides random padding)
+        if(padding != SamplePadding::Random)
+        {
+            std::set<std::array<PREC, 3>> unique;
+            for(unsigned int i = 0; i < sampled1.cols(); ++i)
+            {
+                unique.insert({{sampled1(0, i), sampled1(1, i), sampled1(2, i)}});
+            }
+            ASSERT_EQ(unique.size(), sampled1.cols()) << "padding: " << static_cast<int>(padding);
+        }
+
+        auto o = approximateMVBB(t, 0.001, 200, 5, 0, 6, seed, false, SampleGridMode::Square, padding);
+        ASSERT_LE(o.volume(), 1.1 * reference.volume()) << "padding: " << static_cast<int>(padding);
+    }
+}
+
+MY_TEST(MVBBTest, ParallelDiameter)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, ParallelDiameter);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // Enough points for the parallel scans of the estimator
+    Matrix3Dyn t(3, 200000);
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        Vector3 p(f(0), f(0), f(0));
+        t.col(i) = Vector3(4 * p(0) * p(0) * p(0), 2 * p(1), p(2) * p(0));
+    }
+    pf::applyRandomRotTrans(t, f);
+
+    // Exact diameter from the hull vertices
+    ConvexHull3D hull(t);
+    hull.compute();
+    Matrix3Dyn vertices;
+    hull.getVertices(vertices);
+    PREC diameter = 0;
+    for(unsigned int i = 0; i < vertices.cols(); ++i)
+    {
+        for(unsigned int j = i + 1; j < vertices.cols(); ++j)
+        {
+            diameter = std::max(diameter, (vertices.col(i) - vertices.col(j)).norm());
+        }
+    }
+
+    // Estimate with the pointer list (the scans of util.cpp) on 1 and on all threads
+    const MyMatrix::MatrixStatDyn<double, 3> points = t.cast<double>();
+    const double epsilon                           = 0.001;
+    auto estimate = [&](int nThreads, Diameter::TypeSegment& segment) {
+#if defined(ApproxMVBB_OPENMP_SUPPORT) && defined(_OPENMP)
+        omp_set_num_threads(nThreads);
+#endif
+        std::vector<const double*> list(points.cols());
+        for(unsigned int i = 0; i < points.cols(); ++i)
+        {
+            list[i] = points.col(i).data();
+        }
+        DiameterEstimator estimator(seed);
+        return estimator.estimateDiameter(&segment, list.data(), 0, static_cast<int>(list.size()) - 1, 3, epsilon);
+    };
+
+#if defined(ApproxMVBB_OPENMP_SUPPORT) && defined(_OPENMP)
+    const int nThreads = std::max(omp_get_max_threads(), 4);
+#else
+    const int nThreads = 4;
+#endif
+    Diameter::TypeSegment serial, parallel;
+    double boundSerial   = estimate(1, serial);
+    double boundParallel = estimate(nThreads, parallel);
+#if defined(ApproxMVBB_OPENMP_SUPPORT) && defined(_OPENMP)
+    omp_set_num_threads(nThreads);
+#endif
+
+    ASSERT_EQ(boundSerial, boundParallel);
+    ASSERT_EQ(serial.squareDiameter, parallel.squareDiameter);
+    ASSERT_EQ(serial.extremity1, parallel.extremity1);
+    ASSERT_EQ(serial.extremity2, parallel.extremity2);
+
+    // The estimate lies in [diameter / (1 + epsilon), diameter]
+    PREC estimateDiam = std::sqrt(serial.squareDiameter);
+    ASSERT_LE(estimateDiam, diameter * (1 + 1e-6));
+    ASSERT_GE(estimateDiam * (1 + epsilon), diameter * (1 - 1e-6));
+}
+
+MY_TEST(MVBBTest, DiameterContiguous)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, DiameterContiguous);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // Points with a fourth row, such that the columns are 4 coordinates apart,
+    // in double for the pointer list (also if PREC is float)
+    MyMatrix::MatrixStatDyn<double, 4> t(4, 100000);
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        Vector3 p(f(0), f(0), f(0));
+        t.col(i).head<3>() = Vector3(4 * p(0) * p(0) * p(0), 2 * p(1), p(2) * p(0)).cast<double>();
+        t(3, i)            = f(0);
+    }
+    auto points = t.topRows<3>();
+
+    // The same points in PREC
+    MyMatrix::MatrixStatDyn<PREC, 4> tPrec = t.cast<PREC>();
+    auto pointsPrec                        = tPrec.topRows<3>();
+
+    for(PREC epsilon : {0.0, 0.001, 0.1})
+    {
+        // Pointer list (estimateDiameter) and contiguous storage (estimateDiameter3D)
+        std::vector<double const*> pointList(points.cols());
+        for(unsigned int i = 0; i < points.cols(); ++i)
+        {
+            pointList[i] = points.col(i).data();
+        }
+        DiameterEstimator estimator1(seed), estimator2(seed);
+        Diameter::TypeSegment segment;
+        double bound1 = estimator1.estimateDiameter(
+            &segment, pointList.data(), 0, static_cast<int>(points.cols() - 1), 3, epsilon);
+
+        unsigned int index1, index2;
+        double bound2 = estimator2.estimateDiameter3D(&index1,
+                                                      &index2,
+                                                      points.data(),
+                                                      points.data() + 1,
+                                                      points.data() + 2,
+                                                      static_cast<unsigned int>(points.cols()),
+                                                      4,
+                                                      epsilon);
+
+        ASSERT_EQ(bound1, bound2) << "epsilon: " << epsilon;
+        ASSERT_EQ(segment.extremity1, points.col(index1).data()) << "epsilon: " << epsilon;
+        ASSERT_EQ(segment.extremity2, points.col(index2).data()) << "epsilon: " << epsilon;
+
+        // estimateDiameter<3> reads the PREC points in place
+        DiameterEstimator estimator3(seed);
+        estimator3.estimateDiameter3D(&index1,
+                                      &index2,
+                                      pointsPrec.data(),
+                                      pointsPrec.data() + 1,
+                                      pointsPrec.data() + 2,
+                                      static_cast<unsigned int>(pointsPrec.cols()),
+                                      4,
+                                      epsilon);
+        auto diam = pf::estimateDiameter<3>(pointsPrec, epsilon, seed);
+        ASSERT_TRUE((diam.first.array() == pointsPrec.col(index1).array()).all());
+        ASSERT_TRUE((diam.second.array() == pointsPrec.col(index2).array()).all());
+    }
+}
+
+MY_TEST(MVBBTest, Batch)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, Batch);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // concatenate the point clouds and some random point sets
+    std::vector<Matrix3Dyn> sets;
+    for(unsigned int k = 0; k < 10; k++)
+    {
+        auto v = tf::getPointsFromFile3D(tf::getFileInPath("PointCloud_" + std::to_string(k) + ".txt"));
+        Matrix3Dyn t(3, v.size());
+        for(unsigned int i = 0; i < v.size(); ++i)
+        {
+            t.col(i) = v[i];
+        }
+        pf::applyRandomRotTrans(t, f);
+        sets.push_back(t);
+    }
+    for(unsigned int n : {1, 2, 3, 50, 1000})
+    {
+        Matrix3Dyn t(3, n);
+        sets.push_back(t.unaryExpr(f));
+    }
+
+    std::vector<std::size_t> offsets{0};
+    for(auto& t : sets)
+    {
+        offsets.push_back(offsets.back() + t.cols());
+    }
+    Matrix3Dyn points(3, offsets.back());
+    for(std::size_t i = 0; i < sets.size(); ++i)
+    {
+        points.middleCols(offsets[i], sets[i].cols()) = sets[i];
+    }
+
+    auto oobbsConcat = approximateMVBBBatch(points, offsets, 0.1, 400, 5, 3, 6);
+    auto oobbsSets   = approximateMVBBBatch(sets, 0.1, 400, 5, 3, 6);
+    ASSERT_EQ(oobbsConcat.size(), sets.size());
+    ASSERT_EQ(oobbsSets.size(), sets.size());
+
+    for(std::size_t i = 0; i < sets.size(); ++i)
+    {
+        auto oobb = approximateMVBB(sets[i], 0.1, 400, 5, 3, 6);
+        for(auto* o : {&oobbsConcat[i], &oobbsSets[i]})
+        {
+            ASSERT_NEAR(o->volume(), oobb.volume(), 1e-10 * std::max(oobb.volume(), PREC(1)))
+                << "Batch result differs for set: " << i;
+            ASSERT_TRUE(o->m_minPoint.isApprox(oobb.m_minPoint, 1e-10)) << "Set: " << i;
+            ASSERT_TRUE(o->m_maxPoint.isApprox(oobb.m_maxPoint, 1e-10)) << "Set: " << i;
+        }
+    }
+
+    // the convex hull and the sampling modes are forwarded
+    auto oobbsHull = approximateMVBBBatch(
+        points, offsets, 0.1, 400, 5, 3, 6, seed, true, SampleGridMode::SixFaces, SamplePadding::FarthestPoint);
+    for(std::size_t i = 0; i < sets.size(); ++i)
+    {
+        auto oobb = approximateMVBB(
+            sets[i], 0.1, 400, 5, 3, 6, seed, true, SampleGridMode::SixFaces, SamplePadding::FarthestPoint);
+        ASSERT_NEAR(oobbsHull[i].volume(), oobb.volume(), 1e-10 * std::max(oobb.volume(), PREC(1)))
+            << "Batch result differs for set: " << i;
+    }
+
+    // wrong offsets
+    ASSERT_THROW(approximateMVBBBatch(points, std::vector<std::size_t>{0, 0}, 0.1), ApproxMVBB::Exception);
+    ASSERT_THROW(approximateMVBBBatch(points, std::vector<std::size_t>{0, std::size_t(points.cols()) + 1}, 0.1),
+                 ApproxMVBB::Exception);
+
+    // exceptions of the point sets (too few samples) are rethrown after the parallel region
+    ASSERT_THROW(approximateMVBBBatch(points, offsets, 0.1, 1), ApproxMVBB::Exception);
+    ASSERT_THROW(approximateMVBBBatch(sets, 0.1, 1), ApproxMVBB::Exception);
+}
+
+MY_TEST(MVBBTest, SoAView)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, SoAView);
+    auto f = [&](PREC) { return uni(rng); };
+
+    auto v = tf::getPointsFromFile3D(tf::getFileInPath("PointCloud_0.txt"));
+    Matrix3Dyn t(3, v.size());
+    for(unsigned int i = 0; i < v.size(); ++i)
+    {
+        t.col(i) = v[i];
+    }
+    pf::applyRandomRotTrans(t, f);
+
+    // Separate coordinate arrays
+    std::vector<PREC> x(t.cols()), y(t.cols()), z(t.cols());
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        x[i] = t(0, i);
+        y[i] = t(1, i);
+        z[i] = t(2, i);
+    }
+    auto view = makeSoAPointsView(x.data(), y.data(), z.data(), t.cols());
+    ASSERT_TRUE((Matrix3Dyn(view).array() == t.array()).all());
+
+    // Projection
+    ProjectedPointSet proj;
+    auto oobbProj     = proj.computeMVBB(Vector3(1, 2, 3), t);
+    auto oobbProjView = proj.computeMVBB(Vector3(1, 2, 3), view);
+    ASSERT_TRUE(tf::assertNearArray(oobbProjView.m_minPoint, oobbProj.m_minPoint, 1e-12));
+    ASSERT_TRUE(tf::assertNearArray(oobbProjView.m_maxPoint, oobbProj.m_maxPoint, 1e-12));
+
+    // Diameter
+    auto diam     = pf::estimateDiameter<3>(t, 0.1);
+    auto diamView = pf::estimateDiameter<3>(view, 0.1);
+    ASSERT_TRUE((diamView.first.array() == diam.first.array()).all());
+    ASSERT_TRUE((diamView.second.array() == diam.second.array()).all());
+
+    // Sampling
+    Matrix3Dyn sampled, sampledView;
+    OOBB oobbSample = oobbProj, oobbSampleView = oobbProj;
+    samplePointsGrid(sampled, t, 400, oobbSample);
+    samplePointsGrid(sampledView, view, 400, oobbSampleView);
+    ASSERT_TRUE((sampledView.array() == sampled.array()).all());
+
+    // Whole pipeline
+    auto oobb     = approximateMVBB(t, 0.1, 400, 5, 3, 6);
+    auto oobbView = approximateMVBB(view, 0.1, 400, 5, 3, 6);
+    ASSERT_NEAR(oobbView.volume(), oobb.volume(), 1e-10 * oobb.volume());
+    ASSERT_TRUE(oobbView.m_minPoint.isApprox(oobb.m_minPoint, 1e-10));
+    ASSERT_TRUE(oobbView.m_maxPoint.isApprox(oobb.m_maxPoint, 1e-10));
+
+    // The diameter reads the three arrays in place, the view is never evaluated
+    MVBBWorkspace workspace;
+    auto oobbWorkspace = approximateMVBB(view, workspace, 0.1, 400, 5, 3, 6);
+    ASSERT_EQ(workspace.m_diameterPoints.cols(), 0);
+    ASSERT_NEAR(oobbWorkspace.volume(), oobb.volume(), 1e-10 * oobb.volume());
+}
+
+MY_TEST(MVBBTest, Streaming)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, Streaming);
+    auto f = [&](PREC) { return uni(rng); };
+
+    for(unsigned int k = 0; k < 6; ++k)
+    {
+        Matrix3Dyn t;
+        if(k < 4)
+        {
+            auto v = tf::getPointsFromFile3D(tf::getFileInPath("PointCloud_" + std::to_string(k) + ".txt"));
+            t.resize(3, v.size());
+            for(unsigned int i = 0; i < v.size(); ++i)
+            {
+                t.col(i) = v[i];
+            }
+        }
+        else
+        {
+            t.resize(3, k == 4 ? 300 : 200000);
+            t = t.unaryExpr(f);
+        }
+        pf::applyRandomRotTrans(t, f);
+
+        auto oobb = approximateMVBB(t, 0.001, 400, 5, 2, 6);
+
+        OOBB oobbFirst;
+        for(Matrix3Dyn::Index chunkSize : {Matrix3Dyn::Index(1000), Matrix3Dyn::Index(777), t.cols()})
+        {
+            unsigned int passes = 0;
+            auto producer       = [&](auto&& consume) {
+                ++passes;
+                for(Matrix3Dyn::Index first = 0; first < t.cols(); first += chunkSize)
+                {
+                    consume(t.middleCols(first, std::min(chunkSize, t.cols() - first)));
+                }
+            };
+            auto oobbStream = approximateMVBBStreaming(producer, 0.001, 400, 5, 2, 6);
+            ASSERT_EQ(passes, 5u);
+
+            // Same quality as approximateMVBB
+            ASSERT_LE(oobbStream.volume(), 1.1 * oobb.volume()) << "point set: " << k;
+            ASSERT_LE(oobb.volume(), 1.1 * oobbStream.volume()) << "point set: " << k;
+
+            // Independent of the chunks
+            if(chunkSize == 1000)
+            {
+                oobbFirst = oobbStream;
+            }
+            else
+            {
+                ASSERT_NEAR(oobbStream.volume(), oobbFirst.volume(), 1e-8 * oobbFirst.volume());
+            }
+        }
+    }
+
+    // Incremental projection is the same as the streaming projection
+    Matrix3Dyn t(3, 10000);
+    t = t.unaryExpr(f);
+    ProjectedPointSet proj;
+    auto oobb = proj.computeMVBBStreaming(Vector3(1, 2, 3), t, 1000);
+    proj.beginMVBBStreaming(Vector3(1, 2, 3));
+    for(Matrix3Dyn::Index first = 0; first < t.cols(); first += 1000)
+    {
+        proj.addMVBBStreaming(t.middleCols(first, 1000));
+    }
+    auto oobbIncr = proj.endMVBBStreaming();
+    ASSERT_TRUE((oobbIncr.m_minPoint.array() == oobb.m_minPoint.array()).all());
+    ASSERT_TRUE((oobbIncr.m_maxPoint.array() == oobb.m_maxPoint.array()).all());
+
+    // Points in a ball: only the hull candidates of the projection and the sample are kept in memory
+    t.resize(3, 300000);
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        Vector3 p = Vector3(uni(rng), uni(rng), uni(rng)) - Vector3(0.5, 0.5, 0.5);
+        t.col(i)  = p.normalized() * std::cbrt(uni(rng));
+    }
+    const Matrix3Dyn::Index chunkSize = 1 << 14;
+    MVBBWorkspace workspace;
+    Matrix3Dyn::Index maxCandidates = 0;
+    auto producer                   = [&](auto&& consume) {
+        for(Matrix3Dyn::Index first = 0; first < t.cols(); first += chunkSize)
+        {
+            consume(t.middleCols(first, std::min(chunkSize, t.cols() - first)));
+            maxCandidates = std::max(maxCandidates, workspace.m_proj.getNumberOfCandidates());
+        }
+    };
+    auto oobbBall = approximateMVBBStreaming(producer, workspace, 0.001, 400, 5, 2, 6);
+    ASSERT_LE(maxCandidates, 2 * chunkSize);
+    ASSERT_LE(oobbBall.volume(), 1.1 * approximateMVBB(t, 0.001, 400, 5, 2, 6).volume());
+
+    ASSERT_THROW(approximateMVBBStreaming([](auto&&) {}, 0.001), std::exception);
+}
+
+MY_TEST(MVBBTest, Incremental)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, Incremental);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // Growing elongated point cloud, 300 points per frame
+    const unsigned int nFrames = 100, nFramePoints = 300;
+    Matrix3Dyn t(3, nFrames * nFramePoints);
+    t = t.unaryExpr(f);
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        t(0, i) *= 1.0 + 3.0 * i / t.cols();
+    }
+    pf::applyRandomRotTrans(t, f);
+
+    IncrementalMVBB incr(0.001, 400, 5, 6, 1.1);
+    for(unsigned int frame = 0; frame < nFrames; ++frame)
+    {
+        auto points = t.middleCols(frame * nFramePoints, nFramePoints);
+        incr.add(points);
+
+        // All points so far are in the box
+        const OOBB& oobb = incr.getOOBB();
+        Matrix33 A_KI    = oobb.m_q_KI.matrix().transpose();
+        for(unsigned int i = 0; i < (frame + 1) * nFramePoints; ++i)
+        {
+            Vector3 K_p = A_KI * t.col(i);
+            ASSERT_TRUE((oobb.overlaps<Vector3, false>(K_p))) << "frame: " << frame << " point: " << i;
+        }
+    }
+    ASSERT_EQ(incr.size(), t.cols());
+    ASSERT_LT(incr.gridSearches(), nFrames / 4);
+
+    // Comparable to the box of all points
+    auto oobb = approximateMVBB(t, 0.001, 400, 5, 0, 6);
+    ASSERT_LE(incr.getOOBB().volume(), 1.2 * oobb.volume());
+}
+
+MY_TEST(MVBBTest, ConvexHull)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, ConvexHull);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // Points in a ball (few hull vertices)
+    Matrix3Dyn t(3, 100000);
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        Vector3 p = Vector3(f(0), f(0), f(0)) - Vector3::Constant(0.5);
+        t.col(i)  = p.normalized() * std::cbrt(f(0));
+    }
+    t.row(0) *= 3.0;
+    pf::applyRandomRotTrans(t, f);
+
+    // Boxes containing all points
+    auto unite = [&](OOBB oobb) {
+        Matrix33 A_KI = oobb.m_q_KI.matrix().transpose();
+        for(unsigned int i = 0; i < t.cols(); ++i)
+        {
+            oobb.unite(A_KI * t.col(i));
+        }
+        return oobb;
+    };
+
+    auto oobb     = unite(approximateMVBB(t, 0.001, 400, 5, 0, 6));
+    auto oobbHull = approximateMVBB(t, 0.001, 400, 5, 0, 6, RandomGenerators::defaultSeed, true);
+
+    MVBBWorkspace workspace;
+    auto oobbHullWorkspace = approximateMVBB(t, workspace, 0.001, 400, 5, 0, 6, RandomGenerators::defaultSeed, true);
+    ASSERT_LT(workspace.m_hullVertices.cols(), t.cols() / 10);
+    ASSERT_NEAR(oobbHullWorkspace.volume(), oobbHull.volume(), 1e-10 * oobbHull.volume());
+
+    // The hull vertices give the same box as all points
+    Matrix33 A_KI = oobbHull.m_q_KI.matrix().transpose();
+    OOBB united   = oobbHull;
+    for(unsigned int i = 0; i < workspace.m_hullVertices.cols(); ++i)
+    {
+        united.unite(A_KI * workspace.m_hullVertices.col(i));
+    }
+    ASSERT_NEAR(united.volume(), unite(oobbHull).volume(), 1e-10 * united.volume());
+    ASSERT_LE(united.volume(), 1.05 * oobb.volume());
+}
+
+MY_TEST(MVBBTest, ExactMVBB)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, ExactMVBB);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // Regular tetrahedron: the minimal box is the cube with the edges as face diagonals
+    // (two adjacent faces flush with edges)
+    Matrix3Dyn tet(3, 4);
+    tet << 1, 1, -1, -1, 1, -1, 1, -1, 1, -1, -1, 1;
+    pf::applyRandomRotTrans(tet, f);
+    ASSERT_NEAR(exactMVBB(tet).volume(), 8.0, 1e-9);
+
+    // Box 4x2x1 with interior points
+    Matrix3Dyn box(3, 1008);
+    box.leftCols(1000) = box.leftCols(1000).unaryExpr(f);
+    box.rightCols(8) << 0, 1, 0, 1, 0, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1;
+    box.row(0) *= 4.0;
+    box.row(1) *= 2.0;
+    pf::applyRandomRotTrans(box, f);
+    ASSERT_NEAR(exactMVBB(box).volume(), 8.0, 1e-9);
+
+    // Points in an ellipsoid: not larger than approximateMVBB and contains all points
+    Matrix3Dyn t(3, 2000);
+    for(unsigned int i = 0; i < t.cols(); ++i)
+    {
+        Vector3 p = Vector3(f(0), f(0), f(0)) - Vector3::Constant(0.5);
+        t.col(i)  = p.normalized() * std::cbrt(f(0));
+    }
+    t.row(0) *= 3.0;
+    t.row(1) *= 1.5;
+    pf::applyRandomRotTrans(t, f);
+
+    auto unite = [&](OOBB oobb) {
+        Matrix33 A_KI = oobb.m_q_KI.matrix().transpose();
+        for(unsigned int i = 0; i < t.cols(); ++i)
+        {
+            oobb.unite(A_KI * t.col(i));
+        }
+        return oobb;
+    };
+    auto exact = exactMVBB(t);
+    ASSERT_NEAR(unite(exact).volume(), exact.volume(), 1e-10 * exact.volume());
+    ASSERT_LE(exact.volume(), (1 + 1e-10) * unite(approximateMVBB(t, 0.001, 400, 5, 0, 6)).volume());
+
+    // Coplanar points have a flat box
+    Matrix3Dyn plane(3, 100);
+    plane = plane.unaryExpr(f);
+    plane.row(2).setZero();
+    pf::applyRandomRotTrans(plane, f);
+    ASSERT_NEAR(exactMVBB(plane).volume(), 0.0, 1e-12);
+}
+
+MY_TEST(MVBBTest, WarmStart)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, WarmStart);
+    auto f = [&](PREC) { return uni(rng); };
+
+    // Moving box shaped body
+    Matrix3Dyn body(3, 20000);
+    body = body.unaryExpr(f);
+    body.row(0) *= 4.0;
+    body.row(1) *= 2.0;
+    pf::applyRandomRotTrans(body, f);
+
+    MVBBWorkspace workspace;
+    OOBB oobb = approximateMVBB(body, workspace, 0.001, 400, 5, 0, 6);
+    Matrix3Dyn t(3, body.cols());
+    for(unsigned int frame = 1; frame <= 10; ++frame)
+    {
+        Vector3 axis = Vector3(f(0), f(0), f(0)) - Vector3::Constant(0.5);
+        t = AngleAxis(0.1 * frame, axis.normalized()).toRotationMatrix() * body;
+        t.colwise() += Vector3::Constant(0.1 * frame);
+
+        oobb      = approximateMVBBWarmStart(t, oobb, workspace, 0.001, 400, 2, 5, 6, 1.1);
+        auto full = approximateMVBB(t, workspace, 0.001, 400, 5, 0, 6);
+        ASSERT_LE(oobb.volume(), 1.1 * full.volume()) << "frame: " << frame;
+    }
+
+    // Bad prior: falls back to the full search
+    OOBB prior(Vector3::Zero(), Vector3::Constant(1e-3), Matrix33::Identity());
+    oobb      = approximateMVBBWarmStart(t, prior, 0.001, 400, 2, 5, 6, 1.1);
+    auto full = approximateMVBB(t, workspace, 0.001, 400, 5, 0, 6);
+    ASSERT_LE(oobb.volume(), full.volume());
+}
+
+MY_TEST(MVBBTest, PrimitiveGridDirections)
+{
+    for(unsigned int gridSize : {0, 1, 2, 5, 8})
+    {
+        const auto& dirs = details::primitiveGridDirections(gridSize);
+        ASSERT_EQ(&dirs, &details::primitiveGridDirections(gridSize));
+
+        // Same directions as the full loop with gcd3 (without the opposite directions in the plane z = 0)
+        std::vector<details::GridDirection> expected;
+        int g = static_cast<int>(gridSize);
+        for(int x = -g; x <= g; ++x)
+        {
+            for(int y = -g; y <= g; ++y)
+            {
+                for(int z = 0; z <= g; ++z)
+                {
+                    if(MathFunctions::gcd3(x, y, z) == 1 && (z > 0 || y > 0 || (y == 0 && x > 0)))
+                    {
+                        expected.push_back(details::GridDirection{{x, y, z}});
+                    }
+                }
+            }
+        }
+        ASSERT_EQ(dirs, expected) << "gridSize: " << gridSize;
+    }
+}
+
+MY_TEST(MVBBTest, GridSearchPruning)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, GridSearchPruning);
+    auto f = [&](PREC) { return uni(rng); };
+
+    Matrix3Dyn t(3, 400);
+    t = t.unaryExpr(f);
+    t.row(0) *= 3.0;
+    pf::applyRandomRotTrans(t, f);
+
+    MVBBWorkspace workspace;
+    OOBB start = approximateMVBBDiam(t, workspace, 0.001);
+
+    // The bound is a lower bound of the box volume in all directions
+    details::MVBBVolumeBound bound;
+    bound.init(t, start);
+    ProjectedPointSet proj;
+    for(unsigned int i = 0; i < 100; ++i)
+    {
+        Vector3 dir = Vector3(f(0), f(0), f(0)) - Vector3::Constant(0.5);
+        ASSERT_LE(bound(dir), proj.computeMVBB(dir, t).volume() * (1 + 1e-10)) << "dir: " << dir.transpose();
+    }
+
+    // Exact without optimization loops
+    auto oobb = approximateMVBBGridSearch(t, start, workspace, 0.001, 5, 0);
+    ASSERT_EQ(workspace.m_prunedDirections, 0u);
+    auto oobbPruned = approximateMVBBGridSearch(t, start, workspace, 0.001, 5, 0, 1e-6, 1e-12, true);
+    std::cout << "pruned directions: " << workspace.m_prunedDirections << " of " << workspace.m_gridDirections
+              << std::endl;
+    ASSERT_GT(workspace.m_prunedDirections, 0u);
+    ASSERT_EQ(oobbPruned.volume(), oobb.volume());
+
+    // Parallel version
+    auto oobbParallel = approximateMVBBGridSearch(t, start, 0.001, 5, 0, 1e-6, 1e-12, true);
+    ASSERT_NEAR(oobbParallel.volume(), oobb.volume(), 1e-10 * oobb.volume());
+}
+
+MY_TEST(MVBBTest, DirectionCache)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, DirectionCache);
+    auto f = [&](PREC) { return uni(rng); };
+
+    Matrix3Dyn t(3, 10000);
+    t = t.unaryExpr(f);
+    pf::applyRandomRotTrans(t, f);
+
+    // Opposite directions share one box
+    ProjectedPointSet proj;
+    DirectionCache cache(true);
+    Vector3 dir(1, 2, 3);
+    auto o1 = cache.computeMVBB(proj, dir, t);
+    auto o2 = cache.computeMVBB(proj, -dir, t);
+    ASSERT_EQ(cache.hits(), 1u);
+    ASSERT_EQ(cache.misses(), 1u);
+    ASSERT_EQ(o1.volume(), o2.volume());
+
+    // The default resolution does not merge near-parallel directions
+    cache.computeMVBB(proj, dir + Vector3(1e-6, 0, 0), t);
+    ASSERT_EQ(cache.misses(), 2u);
+
+    // A coarse resolution does, the box of the first direction is returned
+    DirectionCache coarseCache(true, 1e-3);
+    auto c1 = coarseCache.computeMVBB(proj, dir, t);
+    auto c2 = coarseCache.computeMVBB(proj, dir + Vector3(1e-6, 0, 0), t);
+    ASSERT_EQ(coarseCache.hits(), 1u);
+    ASSERT_EQ(c1.volume(), c2.volume());
+    cache.clear();
+    ASSERT_EQ(cache.hits() + cache.misses(), 0u);
+
+    // Grid search with the cache in the workspace
+    MVBBWorkspace workspace;
+    approximateMVBB(t, workspace, 0.001, 400, 5, 0, 6);
+    auto projections = workspace.m_directionCache.misses();
+    ASSERT_EQ(workspace.m_directionCache.hits(), 0u);
+
+    workspace.m_directionCache.setEnabled(true);
+    auto oobb = approximateMVBB(t, workspace, 0.001, 400, 5, 0, 6);
+    std::cout << "direction cache: hits: " << workspace.m_directionCache.hits()
+              << " misses: " << workspace.m_directionCache.misses() << std::endl;
+    ASSERT_GT(workspace.m_directionCache.hits(), 0u);
+    ASSERT_EQ(workspace.m_directionCache.hits() + workspace.m_directionCache.misses(), projections);
+
+    auto oobbNoCache = approximateMVBB(t, 0.001, 400, 5, 0, 6);
+    ASSERT_NEAR(oobb.volume(), oobbNoCache.volume(), 1e-10 * oobbNoCache.volume());
+}
+
+MY_TEST(MVBBTest, MappedPointCloud)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, MappedPointCloud);
+    auto f = [&](PREC) { return uni(rng); };
+
+    Matrix3Dyn t(3, 100000);
+    t = t.unaryExpr(f);
+    auto filename = tf::getFileOutPath(testName, ".pts");
+    writePointCloudFile(filename, t);
+
+    MappedPointCloud cloud(filename);
+    ASSERT_EQ(cloud.dimension(), 3u);
+    ASSERT_EQ(cloud.size(), std::size_t(t.cols()));
+    auto mapped = cloud.points<3>();
+    ASSERT_TRUE((mapped.array() == t.array()).all());
+    ASSERT_THROW(cloud.points<2>(), std::exception);
+
+    // Whole pipeline on the mapped pages
+    auto oobb       = approximateMVBB(t, 0.001, 400, 5, 2, 6);
+    auto oobbMapped = approximateMVBB(mapped, 0.001, 400, 5, 2, 6);
+    ASSERT_TRUE((oobbMapped.m_minPoint.array() == oobb.m_minPoint.array()).all());
+    ASSERT_TRUE((oobbMapped.m_maxPoint.array() == oobb.m_maxPoint.array()).all());
+
+    // Moved cloud keeps the mapping
+    MappedPointCloud moved(std::move(cloud));
+    ASSERT_FALSE(cloud.isOpen());
+    ASSERT_TRUE((moved.points<3>().array() == t.array()).all());
+
+    // Invalid files
+    Matrix2Dyn t2 = t.topRows<2>();
+    writePointCloudFile(filename, t2);
+    ASSERT_THROW(MappedPointCloud{filename}.points<3>(), std::exception);
+    using OtherPREC = std::conditional<std::is_same<PREC, double>::value, float, double>::type;
+    writePointCloudFile(filename, t.cast<OtherPREC>());
+    ASSERT_THROW(MappedPointCloud{filename}, std::exception);
+    ASSERT_THROW(MappedPointCloud{tf::getFileInPath("Bunny.txt")}, std::exception);
+}
+
+MY_TEST(MVBBTest, ReadPointCloudText)
+{
+    MY_TEST_RANDOM_STUFF(MVBBTest, ReadPointCloudText);
+
+    for(std::string name : {"Bunny.txt", "PointCloud_0.txt", "PointCloud_5.txt"})
+    {
+        auto v = tf::getPointsFromFile3D(tf::getFileInPath(name));
+        for(unsigned int nChunks : {0, 1, 3, 64})
+        {
+            Matrix3Dyn t;
+            readPointCloudText(tf::getFileInPath(name), t, nChunks);
+            // the iostream loop might add a point at the end of the file
+            ASSERT_GE(v.size(), t.cols());
+            ASSERT_LE(v.size(), t.cols() + 1);
+            for(unsigned int i = 0; i < t.cols(); ++i)
+            {
+                ASSERT_TRUE((t.col(i).array() == v[i].array()).all()) << name << " point: " << i;
+            }
+        }
+    }
+
+    // Number formats, whitespace and empty lines
+    auto filename = tf::getFileOutPath(testName, ".txt");
+    std::vector<std::string> values = {"1e3", "-2.5E-2", "+3", "0.1", "0.2", "0.3", "-0", "12345678901234567890123",
+                                       "1e-400", "4.9406564584124654e-324", "0.000000000000000000000000001234", "7."};
+    {
+        std::ofstream out(filename);
+        out << "  " << values[0] << " " << values[1] << "\t" << values[2] << "\n\n";
+        out << "\t" << values[3] << "   " << values[4] << " " << values[5] << "  \r\n   \n";
+        out << values[6] << " " << values[7] << " " << values[8] << "\n";
+        out << values[9] << " " << values[10] << " " << values[11];
+    }
+    Matrix3Dyn t;
+    readPointCloudText(filename, t);
+    ASSERT_EQ(t.cols(), 4);
+    for(unsigned int i = 0; i < values.size(); ++i)
+    {
+        ASSERT_EQ(t.data()[i], static_cast<PREC>(std::strtod(values[i].c_str(), nullptr))) << values[i];
+    }
+
+    // Invalid lines
+    for(std::string line : {"1 2", "1 2 3 4", "1 2 a", "1 2 3e", "1,2,3"})
+    {
+        {
+            std::ofstream out(filename);
+            out << "1 2 3\n" << line << "\n4 5 6\n";
+        }
+        ASSERT_THROW(readPointCloudText(filename, t), std::exception) << line;
+    }
+}
+
 //        {
 //            Matrix3Dyn vec(3,140000000);
 //            Matrix3Dyn res(3,140000000);